@@ -0,0 +1,117 @@
+/**
+  \file checksum.h
+
+  \author G. Icking-Konert
+
+  \brief declaration of streaming checksum engine
+
+  declaration of checksum engine with common init / update / final interface for
+  several CRC, Adler and hash algorithms. Data is processed in place, i.e. memory
+  blocks can be streamed without copying. Uses SSE4.2 (CRC32C) and SHA-NI (SHA-256)
+  on x86 if supported by the CPU, else portable table-driven implementations.
+*/
+
+// for including file only once
+#ifndef _CHECKSUM_H_
+#define _CHECKSUM_H_
+
+/**********************
+ INCLUDES
+**********************/
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/**********************
+ GLOBAL DEFINES / MACROS
+**********************/
+
+/// max. size of checksum [B]
+#define CHECKSUM_MAX_SIZE       32
+
+/// min. number of constant bytes for calculating CRC via affine maps, see Checksum_fill()
+#define CHECKSUM_FILL_MIN       4096
+
+/// uncomment to disable SSE4.2 and SHA-NI kernels, e.g. for testing (or via Makefile)
+//#define CHECKSUM_NO_SIMD
+
+
+/**********************
+ GLOBAL STRUCTS
+**********************/
+
+/// supported checksum algorithms
+typedef enum {
+    CHECKSUM_CRC32=0,           //< CRC32-IEEE (zlib, Ethernet), see crc32.h
+    CHECKSUM_CRC16_CCITT,       //< CRC16-CCITT (polynom 0x1021, init 0xFFFF, not reflected)
+    CHECKSUM_CRC32C,            //< CRC32C (Castagnoli, polynom 0x1EDC6F41, reflected)
+    CHECKSUM_CRC32_MPEG2,       //< CRC32-MPEG2 (polynom 0x04C11DB7, init 0xFFFFFFFF, not reflected, no final XOR)
+    CHECKSUM_ADLER32,           //< Adler-32 (zlib)
+    CHECKSUM_SHA256,            //< SHA-256 (FIPS 180-4)
+    CHECKSUM_UNKNOWN            //< unsupported algorithm
+} checksum_t;
+
+/// state of checksum calculation
+typedef struct {
+    checksum_t          algo;           //< checksum algorithm
+    uint32_t            crc;            //< state of CRC or Adler-32
+    uint32_t            hash[8];        //< SHA-256 only: hash state
+    uint8_t             block[64];      //< SHA-256 only: incomplete message block
+    uint64_t            length;         //< SHA-256 only: total message length [B]
+} Checksum_s;
+
+
+/**********************
+ GLOBAL FUNCTIONS
+**********************/
+
+/// @brief get checksum algorithm from name, e.g. for commandline option
+/// @param[in]  name      algorithm name (crc32, crc16, crc32c, crc32-mpeg2, adler32, sha256). May be NULL
+/// @return checksum algorithm, or CHECKSUM_UNKNOWN if not supported
+checksum_t Checksum_getAlgorithm(const char* name);
+
+/// @brief get display name of checksum algorithm, e.g. "CRC32-IEEE"
+/// @param[in]  algo      checksum algorithm
+/// @return display name
+const char* Checksum_getName(const checksum_t algo);
+
+/// @brief get size of checksum
+/// @param[in]  algo      checksum algorithm
+/// @return size of checksum [B]
+size_t Checksum_getSize(const checksum_t algo);
+
+/// @brief start checksum calculation
+/// @param      chk       pointer to checksum state
+/// @param[in]  algo      checksum algorithm
+void Checksum_init(Checksum_s* chk, const checksum_t algo);
+
+/// @brief add data to checksum
+/// @param      chk       pointer to checksum state
+/// @param[in]  data      data to add
+/// @param[in]  len       number of bytes to add
+void Checksum_update(Checksum_s* chk, const void* data, const size_t len);
+
+/// @brief add a byte value repeatedly to checksum, e.g. for gaps in memory image. CRC and Adler-32
+///        need O(log len) resp. O(1) operations, SHA-256 processes all bytes
+/// @param      chk       pointer to checksum state
+/// @param[in]  value     byte value to add
+/// @param[in]  len       number of bytes to add
+void Checksum_fill(Checksum_s* chk, const uint8_t value, const uint64_t len);
+
+/// @brief finish checksum calculation
+/// @param      chk       pointer to checksum state
+/// @param[out] digest    checksum, Checksum_getSize() bytes in big-endian order
+void Checksum_final(Checksum_s* chk, uint8_t* digest);
+
+/// @brief convert checksum to string, i.e. "0x..." for CRC and Adler-32, plain hex digits for SHA-256
+/// @param[in]  algo      checksum algorithm
+/// @param[in]  digest    checksum from Checksum_final()
+/// @param[out] str       result string
+/// @param[in]  lenStr    size of result buffer, min. 2*CHECKSUM_MAX_SIZE+3
+/// @return pointer to result string
+const char* Checksum_toString(const checksum_t algo, const uint8_t* digest, char* str, const size_t lenStr);
+
+#endif // _CHECKSUM_H_
+
+// end of file
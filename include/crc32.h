@@ -0,0 +1,55 @@
+/**
+  \file crc32.h
+
+  \author G. Icking-Konert
+
+  \brief declaration of fast CRC32-IEEE calculation
+
+  declaration of CRC32-IEEE calculation. Uses carry-less multiplication (PCLMULQDQ)
+  on x86 if supported by the CPU, else slicing-by-8, i.e. 8 data bytes are
+  processed per step using 8 lookup tables.
+*/
+
+// for including file only once
+#ifndef _CRC32_H_
+#define _CRC32_H_
+
+/**********************
+ INCLUDES
+**********************/
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/**********************
+ GLOBAL DEFINES / MACROS
+**********************/
+
+/// CRC32-IEEE polynom (reflected)
+#define CRC32_IEEE_POLYNOM      0xEDB88320
+
+/// uncomment to disable PCLMULQDQ folding, e.g. for testing (or via Makefile)
+//#define CRC32_NO_SIMD
+
+
+/**********************
+ GLOBAL FUNCTIONS
+**********************/
+
+/// @brief update CRC32-IEEE register with data. Initial value and final XOR (0xFFFFFFFF) are applied by the caller
+/// @param[in]  crc   current CRC register
+/// @param[in]  data  data to add
+/// @param[in]  len   number of bytes to add
+/// @return updated CRC register
+uint32_t crc32_update(uint32_t crc, const void *data, const size_t len);
+
+/// @brief combine CRC32-IEEE checksums of two consecutive data blocks A and B into checksum of A+B (like zlib crc32_combine)
+/// @param[in]  crc1  final checksum of first block A
+/// @param[in]  crc2  final checksum of second block B
+/// @param[in]  len2  length of second block B [B]
+/// @return final checksum of A+B
+uint32_t crc32_join(const uint32_t crc1, const uint32_t crc2, uint64_t len2);
+
+#endif // _CRC32_H_
+
+// end of file
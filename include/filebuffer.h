@@ -0,0 +1,62 @@
+/**
+  \file filebuffer.h
+
+  \author G. Icking-Konert
+
+  \brief declaration of read-only file buffer
+
+  declaration of read-only buffer holding the complete content of a file.
+  Regular files are memory mapped if supported by the OS, else (e.g. for pipes)
+  read in large blocks. File name "-" denotes stdin. Compressed files are decompressed into memory, which
+  requires zlib (HAVE_ZLIB) for gzip and liblzma (HAVE_LZMA) for xz.
+*/
+
+// for including file only once
+#ifndef _FILEBUFFER_H_
+#define _FILEBUFFER_H_
+
+/**********************
+ INCLUDES
+**********************/
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/**********************
+ GLOBAL DEFINES / MACROS
+**********************/
+
+/// block size for reading non-mappable or compressed files [B]
+#define FILEBUFFER_BLOCK_SIZE   (1024*1024)
+
+
+/**********************
+ GLOBAL STRUCTS
+**********************/
+
+/// read-only file content
+typedef struct {
+    const uint8_t*      data;           //< file content. Not NUL terminated!
+    size_t              size;           //< size of file content [B]
+    bool                mapped;         //< content is memory mapped (else allocated)
+} FileBuffer_s;
+
+
+/**********************
+ GLOBAL FUNCTIONS
+**********************/
+
+/// @brief open file and make its content available in memory. gzip or xz compressed content is decompressed
+/// @param      buf       pointer to file buffer
+/// @param[in]  filename  name of file to read, or "-" for stdin
+/// @return operation successful. On failure errno describes the error
+bool FileBuffer_open(FileBuffer_s* buf, const char* filename);
+
+/// @brief release file content
+/// @param      buf       pointer to file buffer
+void FileBuffer_close(FileBuffer_s* buf);
+
+#endif // _FILEBUFFER_H_
+
+// end of file
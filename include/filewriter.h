@@ -0,0 +1,92 @@
+/**
+  \file filewriter.h
+
+  \author G. Icking-Konert
+
+  \brief declaration of output file with optional compression
+
+  declaration of output file which is compressed on the fly depending on the
+  file name suffix, i.e. *.gz (gzip) or *.xz (xz). Compression requires zlib
+  (HAVE_ZLIB) or liblzma (HAVE_LZMA), see Makefile. File name "-" denotes stdout.
+*/
+
+// for including file only once
+#ifndef _FILEWRITER_H_
+#define _FILEWRITER_H_
+
+/**********************
+ INCLUDES
+**********************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/**********************
+ GLOBAL DEFINES / MACROS
+**********************/
+
+/// size of buffer for compressed data [B]
+#define FILEWRITER_BLOCK_SIZE   (64*1024)
+
+
+/**********************
+ GLOBAL STRUCTS
+**********************/
+
+/// compression of file content
+typedef enum {COMPRESS_NONE=0, COMPRESS_GZIP, COMPRESS_XZ} compress_t;
+
+/// output file
+typedef struct {
+    FILE*               fp;             //< output file
+    compress_t          compress;       //< compression of file content
+    void*               stream;         //< compressor state, depending on compression
+    uint8_t*            buf;            //< buffer for compressed data
+    uint64_t            sizeHoles;      //< number of bytes skipped as holes, see FileWriter_fill()
+} FileWriter_s;
+
+
+/**********************
+ GLOBAL FUNCTIONS
+**********************/
+
+/// @brief get compression from file name suffix
+/// @param[in]  filename  name of file
+/// @return COMPRESS_GZIP for *.gz, COMPRESS_XZ for *.xz, else COMPRESS_NONE
+compress_t FileWriter_getCompression(const char* filename);
+
+/// @brief set stream for file name "-", e.g. after redirecting console output. Default is stdout
+/// @param[in]  fp        output stream
+void FileWriter_setStdout(FILE* fp);
+
+/// @brief create output file. Compression depends on file name suffix
+/// @param      file      pointer to output file
+/// @param[in]  filename  name of file to create, or "-" for stdout
+/// @return operation successful. On failure errno describes the error
+bool FileWriter_open(FileWriter_s* file, const char* filename);
+
+/// @brief write data to output file
+/// @param      file      pointer to output file
+/// @param[in]  data      data to write
+/// @param[in]  len       number of bytes to write
+/// @return operation successful
+bool FileWriter_write(FileWriter_s* file, const void* data, const size_t len);
+
+/// @brief write a byte value repeatedly to output file, e.g. for gaps in binary data. Zeros are
+///        skipped as holes in uncompressed seekable files (sparse file), else written in large chunks
+/// @param      file      pointer to output file
+/// @param[in]  value     byte value to write
+/// @param[in]  len       number of bytes to write
+/// @return operation successful
+bool FileWriter_fill(FileWriter_s* file, const uint8_t value, const uint64_t len);
+
+/// @brief finish compression and close output file
+/// @param      file      pointer to output file
+/// @return operation successful, i.e. all data was written
+bool FileWriter_close(FileWriter_s* file);
+
+#endif // _FILEWRITER_H_
+
+// end of file
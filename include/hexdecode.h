@@ -0,0 +1,46 @@
+/**
+  \file hexdecode.h
+
+  \author G. Icking-Konert
+
+  \brief declaration of fast hex string decoder
+
+  declaration of hex string decoder for S19 and IHX records. Uses SSE2/AVX2
+  on x86 if supported by the CPU, else a portable lookup table decoder.
+*/
+
+// for including file only once
+#ifndef _HEXDECODE_H_
+#define _HEXDECODE_H_
+
+/**********************
+ INCLUDES
+**********************/
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/**********************
+ GLOBAL DEFINES / MACROS
+**********************/
+
+/// uncomment to disable SIMD decoder, e.g. for testing (or via Makefile)
+//#define HEXDECODE_NO_SIMD
+
+
+/**********************
+ GLOBAL FUNCTIONS
+**********************/
+
+/// @brief decode hex string into bytes and add them to checksum
+/// @param[out] data  decoded bytes
+/// @param[in]  str   hex string, 2 characters per byte. Both cases are accepted. Must contain min. 2*len characters
+/// @param[in]  len   number of bytes to decode
+/// @param      sum   checksum, decoded bytes are added (modulo 256)
+/// @return all characters are valid hex digits
+bool hex_decode(uint8_t *data, const char *str, const size_t len, uint8_t *sum);
+
+#endif // _HEXDECODE_H_
+
+// end of file
@@ -19,34 +19,77 @@
  INCLUDES
 **********************/
 #include "memory_image.h"
+#include "checksum.h"
+
+
+/**********************
+ GLOBAL DEFINES / STRUCTS
+**********************/
+
+/// max. length of error messages from parsing, incl. terminating NUL
+#define IMPORT_ERROR_LEN    (256)
+
+/// supported file formats
+typedef enum {FORMAT_S19=0, FORMAT_IHX, FORMAT_TXT, FORMAT_BIN, FORMAT_UNKNOWN} format_t;
+
+/// parameters for importing a file, e.g. for concurrent import of several files
+typedef struct {
+  const char        *filename;      //< full name of file to read
+  format_t          format;         //< file format, FORMAT_UNKNOWN for autodetection
+  MEMIMAGE_ADDR_T   addrStart;      //< binary only: address offset
+  uint64_t          offset;         //< binary only: first byte in file to import
+  uint64_t          length;         //< binary only: number of bytes to import, or 0 for remainder of file
+} ImportFile_s;
 
 
 /**********************
  GLOBAL FUNCTIONS
 **********************/
 
+/// get file format from extension (e.g. ".s19") or name (e.g. "s19")
+format_t get_format(const char *name);
+
+/// detect file format from start of file content
+format_t detect_format(const uint8_t *buf, const size_t lenBuf);
+
+
 /// read Motorola s19 file into memory image
-void  import_file_s19(const char *filename, MemoryImage_s *image, const uint8_t verbose);
+void  import_file_s19(const char *filename, MemoryImage_s *image, const int numThreads, const uint8_t verbose);
 
 /// read Intel hex file into memory image
-void  import_file_ihx(const char *filename, MemoryImage_s *image, const uint8_t verbose);
+void  import_file_ihx(const char *filename, MemoryImage_s *image, const int numThreads, const uint8_t verbose);
 
 /// read plain text table (hex addr / data) file into memory image
 void  import_file_txt(const char *filename, MemoryImage_s *image, const uint8_t verbose);
 
-/// read binary file into memory image
-void  import_file_bin(const char *filename, const MEMIMAGE_ADDR_T addrStart, MemoryImage_s *image, const uint8_t verbose);
+/// read binary file or slice of it into memory image
+void  import_file_bin(const char *filename, const MEMIMAGE_ADDR_T addrStart, const uint64_t offset, const uint64_t length, MemoryImage_s *image, const uint8_t verbose);
+
+/// read file with autodetected format into memory image. Returns detected format
+format_t import_file_auto(const char *filename, const MEMIMAGE_ADDR_T addrStart, const uint64_t offset, const uint64_t length, MemoryImage_s *image, const int numThreads, const uint8_t verbose);
+
+/// read several files concurrently into memory image. Later files overwrite earlier ones
+void  import_files(const ImportFile_s *files, const int numFiles, MemoryImage_s *image, const int numThreads, const uint8_t verbose);
 
 
-/// read Motorola s19 RAM buffer into memory image
+/// read Motorola s19 RAM buffer (NUL terminated) into memory image
 void  import_buffer_s19(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose);
 
-/// read Intel hex RAM buffer into memory image
+/// read Intel hex RAM buffer (NUL terminated) into memory image
 void  import_buffer_ihx(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose);
 
-/// read plain text table (hex addr / data) RAM buffer into memory image
+/// read plain text table (hex addr / data) RAM buffer (NUL terminated) into memory image
 void  import_buffer_txt(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose);
 
+/// read Motorola s19 RAM buffer of given length into memory image. Returns false and error message on failure, no output
+bool  import_buffer_s19_len(const uint8_t *buf, const size_t lenBuf, MemoryImage_s *image, char *error);
+
+/// read Intel hex RAM buffer of given length into memory image. Returns false and error message on failure, no output
+bool  import_buffer_ihx_len(const uint8_t *buf, const size_t lenBuf, MemoryImage_s *image, char *error);
+
+/// read plain text table RAM buffer of given length into memory image. Returns false and error message on failure, no output
+bool  import_buffer_txt_len(const uint8_t *buf, const size_t lenBuf, MemoryImage_s *image, char *error);
+
 /// read binary RAM buffer into memory image
 void  import_buffer_bin(const uint8_t *buf, const uint64_t lenBuf, const MEMIMAGE_ADDR_T addrStart, MemoryImage_s *image, const uint8_t verbose);
 
@@ -61,8 +104,17 @@ void  export_file_ihx(char *filename, MemoryImage_s *image, const uint8_t verbos
 void  export_file_txt(char *filename, MemoryImage_s *image, const uint8_t verbose);
 
 /// export RAM image to binary file (w/o address)
-void  export_file_bin(char *filename, MemoryImage_s *image, const uint8_t verbose);
+void  export_file_bin(char *filename, MemoryImage_s *image, const uint8_t fill, const uint8_t verbose);
+
+
+/// calculate CRC32-IEEE checksums of memory blocks and whole image in parallel
+uint32_t checksum_image(const MemoryImage_s *image, uint32_t *chkBlocks, const int numThreads);
+
+/// calculate checksums of memory blocks with selected algorithm in parallel
+void  checksum_blocks(const MemoryImage_s *image, const checksum_t algo, uint8_t *digests, const int numThreads);
 
+/// calculate checksum over address window with gaps read as fill value
+void  checksum_window(MemoryImage_s *image, const checksum_t algo, const MEMIMAGE_ADDR_T addrStart, const MEMIMAGE_ADDR_T addrStop, const uint8_t fill, uint8_t *digest);
 
 /// fill data in memory image with fixed value
 void  fill_image(MemoryImage_s *image, const MEMIMAGE_ADDR_T addrStart, const MEMIMAGE_ADDR_T addrStop, const uint8_t value, const uint8_t verbose);
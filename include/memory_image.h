@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "crc32.h"
 
 
 /**********************
@@ -34,36 +35,60 @@
 /// memory image address datatype / width
 #define MEMIMAGE_ADDR_T         uint64_t
 
-/// grow/shrink factor for memory image buffer. Must be >1.0!
+/// grow/shrink factor for memory image buffers. Must be >1.0!
 #define MEMIMAGE_BUFFER_MARGIN  1.3
 
-/// max. size for memory image buffer [B]
-#define MEMIMAGE_BUFFER_MAX     50L*1024L*1024L
+/// max. total size of data in memory image [B]
+#define MEMIMAGE_BUFFER_MAX     1024L*1024L*1024L
 
-/// CRC32-IEEE polynom
-#define CRC32_IEEE_POLYNOM      0xEDB88320
+/// number of checksummed bytes per data byte, see MemoryImage_checksum_crc32()
+#if defined(MEMIMAGE_CHK_INCLUDE_ADDRESS)
+    #define MEMIMAGE_CHK_BYTES  (sizeof(MEMIMAGE_ADDR_T)+1)
+#else
+    #define MEMIMAGE_CHK_BYTES  1
+#endif
 
 
 /**********************
  GLOBAL STRUCTS
 **********************/
 
-/// memory entry consisting of address and data 
+/// memory segment consisting of start address and consecutive data
+typedef struct {
+    MEMIMAGE_ADDR_T     address;        //< start address of segment
+    uint8_t*            data;           //< data buffer, data[i] is located at address+i
+    size_t              numBytes;       //< number of used data bytes
+    size_t              capacity;       //< reserved data capacity [B]
+} MemorySegment_s;
+
+
+/// memory image container. Segments are sorted by address and neither overlap nor touch
+typedef struct {
+    MemorySegment_s*    segments;       //< memory segments 
+    size_t              numSegments;    //< number of used segments 
+    size_t              capacity;       //< reserved segment capacity 
+    size_t              numEntries;     //< total number of data bytes in all segments
+    size_t              countAppend;    //< number of insertions behind last segment, i.e. without search
+    size_t              countSearch;    //< number of insertions requiring a segment search
+#if defined(MEMIMAGE_DEBUG)
+    uint8_t             debug;          //< debug output level (0..2)
+#endif
+} MemoryImage_s;
+
+
+/// memory entry consisting of address and data, e.g. for staging unsorted data
 typedef struct {
     MEMIMAGE_ADDR_T     address;        //< address 
     uint8_t             data;           //< data
 } MemoryEntry_s;
 
 
-/// memory image container  
+/// staging buffer for deferred import of unsorted data. Entries are kept in order of insertion
 typedef struct {
-    MemoryEntry_s*      memoryEntries;  //< memory entries 
+    MemoryEntry_s*      entries;        //< staged entries 
     size_t              numEntries;     //< number of used entries 
     size_t              capacity;       //< reserved capacity 
-#if defined(MEMIMAGE_DEBUG)
-    uint8_t             debug;          //< debug output level (0..2)
-#endif
-} MemoryImage_s;
+} MemoryStaging_s;
 
 
 /**********************
@@ -102,12 +127,27 @@ void MemoryImage_print(const MemoryImage_s* image, FILE* fp);
 /// @return operation successful
 bool MemoryImage_addData(MemoryImage_s* image, const MEMIMAGE_ADDR_T address, const uint8_t data);
 
+/// @brief add consecutive data at specified address in memory image. Existing content is overwritten
+/// @param      image     pointer to memory image
+/// @param[in]  address   address of first byte
+/// @param[in]  buf       data to add
+/// @param[in]  len       number of bytes to add
+/// @return operation successful
+bool MemoryImage_addBlock(MemoryImage_s* image, const MEMIMAGE_ADDR_T address, const uint8_t *buf, const size_t len);
+
 /// @brief remove byte from specified address in memory image
 /// @param      image     pointer to memory image
 /// @param[in]  address   address to remove entry from
 /// @return operation successful
 bool MemoryImage_deleteData(MemoryImage_s* image, const MEMIMAGE_ADDR_T address);
 
+/// @brief remove all data inside address range [addrStart;addrEnd] from memory image
+/// @param      image     pointer to memory image
+/// @param[in]  addrStart start address (inclusive)
+/// @param[in]  addrEnd   end address (inclusive)
+/// @return operation successful
+bool MemoryImage_deleteRange(MemoryImage_s* image, const MEMIMAGE_ADDR_T addrStart, const MEMIMAGE_ADDR_T addrEnd);
+
 /// @brief get byte from specified address in memory image
 /// @param[in]  image     pointer to memory image
 /// @param[in]  address   address read from
@@ -115,27 +155,44 @@ bool MemoryImage_deleteData(MemoryImage_s* image, const MEMIMAGE_ADDR_T address)
 /// @return operation successful
 bool MemoryImage_getData(const MemoryImage_s* image, const MEMIMAGE_ADDR_T address, uint8_t *data);
 
-/// @brief find indes of specified address in memory image
+/// @brief get consecutive data starting at specified address in memory image. Missing data is set to 0x00
+/// @param[in]  image     pointer to memory image
+/// @param[in]  address   address of first byte
+/// @param[out] buf       read data
+/// @param[in]  len       number of bytes to read
+/// @return operation successful, i.e. all addresses in image
+bool MemoryImage_getBlock(const MemoryImage_s* image, const MEMIMAGE_ADDR_T address, uint8_t *buf, const size_t len);
+
+/// @brief find index of memory segment containing specified address
 /// @param[in]  image   pointer to memory image
 /// @param[in]  address address to find
-/// @param[out] index   index if address if found, else matching position, i.e. index of upper neighbour
+/// @param[out] index   segment index if address is found, else matching position, i.e. index of upper neighbour segment
 /// @return search successful, i.e. address in image
 bool MemoryImage_getIndex(const MemoryImage_s* image, const MEMIMAGE_ADDR_T address, size_t *index);
 
-/// @brief get next consecutive memory block, starting at addrStart
+/// @brief get next consecutive memory block, i.e. segment containing addrStart or following it
 /// @param[in]  image       pointer to memory image
 /// @param[in]  addrStart   start address of search (inclusive)
-/// @param[out] idxStart    first index of next memory block (inclusive)
-/// @param[out] idxEnd      last index of next memory block (inclusive)
-/// @return search successful, i.e. address in image
-bool MemoryImage_getMemoryBlock(const MemoryImage_s* image, const MEMIMAGE_ADDR_T addrStart, size_t *idxStart, size_t *idxEnd);
+/// @param[out] idxSegment  index of memory segment
+/// @return search successful, i.e. block found
+bool MemoryImage_getMemoryBlock(const MemoryImage_s* image, const MEMIMAGE_ADDR_T addrStart, size_t *idxSegment);
 
-/// @brief calculate CRC32 checksum over index range (see https://www.mikrocontroller.net/attachment/61520/crc32_v1.c)
+/// @brief get lowest address in memory image
+/// @param[in]  image     pointer to memory image
+/// @return lowest address, or 0 for empty image
+MEMIMAGE_ADDR_T MemoryImage_getFirstAddress(const MemoryImage_s* image);
+
+/// @brief get highest address in memory image
+/// @param[in]  image     pointer to memory image
+/// @return highest address, or 0 for empty image
+MEMIMAGE_ADDR_T MemoryImage_getLastAddress(const MemoryImage_s* image);
+
+/// @brief calculate CRC32-IEEE checksum over data in address range. Contiguous data is processed via slicing-by-8 (see crc32.h)
 /// @param[in]  image     pointer to memory image 
-/// @param[in]  idxStart  start index (inclusive)
-/// @param[in]  idxEnd    end index (inclusive)
+/// @param[in]  addrStart start address (inclusive)
+/// @param[in]  addrEnd   end address (inclusive)
 /// @return calculated CRC32 little endian checksum
-uint32_t MemoryImage_checksum_crc32(const MemoryImage_s* image, const size_t idxStart, const size_t idxEnd);
+uint32_t MemoryImage_checksum_crc32(const MemoryImage_s* image, const MEMIMAGE_ADDR_T addrStart, const MEMIMAGE_ADDR_T addrEnd);
 
 /// @brief fill address range [addrStart;addrEnd] with fixed value 
 /// @param      image     pointer to memory image
@@ -178,6 +235,13 @@ bool MemoryImage_clone(const MemoryImage_s* srcImage, MemoryImage_s* destImage);
 /// @return operation successful
 bool MemoryImage_merge(const MemoryImage_s* srcImage, MemoryImage_s* destImage);
 
+/// @brief merge multiple memory images in single pass. On overlap, later images in list have priority
+/// @param[in]  srcImages list of pointers to source images. May contain destImage
+/// @param[in]  numImages number of source images
+/// @param      destImage pointer to resulting memory image. Previous content is replaced
+/// @return operation successful
+bool MemoryImage_mergeImages(const MemoryImage_s* const srcImages[], const size_t numImages, MemoryImage_s* destImage);
+
 /// @brief copy address range [addrFromStart;addrFromEnd] to new addresses starting at addrToStart. Existing data is overwritten, empty data is ignored
 /// @param      image     pointer to memory image
 /// @param[in]  addrFromStart source start address (inclusive)
@@ -194,6 +258,27 @@ bool MemoryImage_copyRange(MemoryImage_s* image, const MEMIMAGE_ADDR_T addrFromS
 /// @return operation successful
 bool MemoryImage_moveRange(MemoryImage_s* image, const MEMIMAGE_ADDR_T addrFromStart, const MEMIMAGE_ADDR_T addrFromEnd, const MEMIMAGE_ADDR_T addrToStart);
 
+/// @brief initialize empty staging buffer
+/// @param staging        pointer to staging buffer
+void MemoryStaging_init(MemoryStaging_s* staging);
+
+/// @brief release staging buffer
+/// @param staging        pointer to staging buffer
+void MemoryStaging_free(MemoryStaging_s* staging);
+
+/// @brief append byte to staging buffer. Addresses may be unsorted or repeated
+/// @param      staging   pointer to staging buffer
+/// @param[in]  address   address of entry
+/// @param[in]  data      data of entry
+/// @return operation successful
+bool MemoryStaging_addData(MemoryStaging_s* staging, const MEMIMAGE_ADDR_T address, const uint8_t data);
+
+/// @brief sort staging buffer and merge it into memory image, then clear staging buffer. For repeated addresses the last entry wins
+/// @param      staging   pointer to staging buffer
+/// @param      image     pointer to memory image
+/// @return operation successful
+bool MemoryStaging_commit(MemoryStaging_s* staging, MemoryImage_s* image);
+
 #endif // _IMAGE_H_
 
 // end of file
@@ -89,6 +89,24 @@ bool isHexString(const char *str);
 /// check endianness of machine
 bool isLittleEndian(void);
 
+/// get file name extension w/o compression suffix (.gz, .xz)
+const char* getExtension(const char *filename, char *ext, const size_t maxLen);
+
+/// redirect stdout to stderr and return stream to original stdout
+FILE* redirectStdout(void);
+
+/// get number of available CPU cores
+int getNumCores(void);
+
+/// execute function for array of tasks in parallel threads and wait for completion
+void runParallel(void* (*func)(void*), void *tasks, const size_t sizeTask, const int numTasks);
+
+/// CPU features for runtime selection of SIMD kernels (x86 only)
+typedef enum {CPU_SSE2=0, CPU_SSE41, CPU_SSE42, CPU_AVX2, CPU_PCLMUL, CPU_SHA} cpuFeature_t;
+
+/// check if CPU supports a feature. Is detected on first call
+bool cpuHas(const cpuFeature_t feature);
+
 #endif // _MISC_H_
 
 // end of file
@@ -28,7 +28,31 @@ Revision History
 ----------------
 
 v1.6.3b (2023-xx-xx)
-  - just a placeholder for now
+  - store memory image as sorted list of consecutive segments (~1B per data byte instead of 16B)
+  - added MemoryImage_addBlock() / MemoryImage_getBlock() for bulk data access
+  - append data behind last segment without search (fast path for sorted imports)
+  - import tables via staging buffer with single sort and merge
+  - remove address ranges in clip and cut at once via MemoryImage_deleteRange()
+  - merge memory images in single linear pass, add k-way MemoryImage_mergeImages()
+  - copy and move address ranges without cloning entire image
+  - export S19 and IHX records block-wise via lookup table encoder and buffered output
+  - decode S19 and IHX records via lookup table with checksum validation in same pass
+  - decode hex record payloads with SSE2/AVX2 if supported by CPU
+  - read S19, IHX and table files via memory mapping w/o line length limit
+  - import binary files as single block, with optional file offset and length
+  - parse large S19 and IHX files in parallel chunks (option -threads)
+  - read consecutive imports concurrently and merge them in commandline order
+  - added import_buffer_*_len() with const buffer and length, returning errors instead of exit. Buffer is not modified
+  - faster single-pass parser for ASCII tables with error check
+  - import and export gzip or xz compressed files (*.gz, *.xz) via optional zlib / liblzma
+  - import from stdin and export to stdout via file name '-' and option -format
+  - detect import format from file content for unknown extensions (e.g. *.srec, *.mot, *.a43)
+  - export binary files with bulk writes and sparse holes for gaps, fill value via option -binFill
+  - CRC32 checksum via slicing-by-8 lookup tables
+  - CRC32 checksum via PCLMULQDQ folding on x86, if supported by the CPU
+  - calculate checksums of large memory blocks in parallel chunks (option -threads)
+  - checksum engine with CRC16-CCITT, CRC32C, CRC32-MPEG2, Adler-32 and SHA-256 (option -checksum [algo])
+  - checksum over address window with gaps read as fill value, without filling image (option -checksum [algo] [start stop fill])
 
 ----------------
 
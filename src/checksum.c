@@ -0,0 +1,615 @@
+/**
+  \file checksum.c
+
+  \author G. Icking-Konert
+
+  \brief implementation of streaming checksum engine
+
+  implementation of checksum engine with common init / update / final interface for
+  several CRC, Adler and hash algorithms. Data is processed in place, i.e. memory
+  blocks can be streamed without copying. Uses SSE4.2 (CRC32C) and SHA-NI (SHA-256)
+  on x86 if supported by the CPU, else portable table-driven implementations.
+*/
+
+/**********************
+ INCLUDES
+**********************/
+#include <stdio.h>
+#include <string.h>
+#include "checksum.h"
+#include "crc32.h"
+#include "misc.h"
+
+// use SSE4.2 and SHA-NI kernels only for x86-64 and GCC compatible compilers
+#if !defined(CHECKSUM_NO_SIMD) && defined(__x86_64__) && defined(__GNUC__)
+  #define CHECKSUM_X86
+  #include <immintrin.h>
+#endif
+
+
+/**********************
+ LOCAL DEFINES
+**********************/
+
+/// CRC16-CCITT polynom
+#define CRC16_CCITT_POLYNOM     0x1021
+
+/// CRC32C polynom (reflected)
+#define CRC32C_POLYNOM          0x82F63B78
+
+/// CRC32-MPEG2 polynom
+#define CRC32_MPEG2_POLYNOM     0x04C11DB7
+
+/// Adler-32 modulus
+#define ADLER32_BASE            65521
+
+/// max. number of bytes before Adler-32 sums must be reduced, see zlib
+#define ADLER32_NMAX            5552
+
+/// type of SHA-256 block function
+typedef void (*sha256_blocks_t)(uint32_t hash[8], const uint8_t* data, size_t numBlocks);
+
+/// type of CRC32C update function
+typedef uint32_t (*crc32c_update_t)(uint32_t crc, const uint8_t* data, size_t len);
+
+/// affine map of CRC register over GF(2), i.e. crc -> M*crc ^ b. Used to skip constant data
+typedef struct {
+    uint32_t            col[32];        //< columns of matrix M, i.e. images of single register bits
+    uint32_t            b;              //< constant part, i.e. image of zero register
+} CrcMap_s;
+
+
+/**********************
+ LOCAL VARIABLES
+**********************/
+
+/// names of checksum algorithms for commandline and display
+static const char* algoName[]    = { "crc32", "crc16", "crc32c", "crc32-mpeg2", "adler32", "sha256" };
+static const char* algoDisplay[] = { "CRC32-IEEE", "CRC16-CCITT", "CRC32C", "CRC32-MPEG2", "Adler-32", "SHA-256" };
+static const size_t algoSize[]   = { 4, 2, 4, 4, 4, 32 };
+
+/// lookup table for bytewise CRC16-CCITT, MSB first. Generated offline from CRC16_CCITT_POLYNOM
+static const uint16_t crc16Table[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+};
+
+/// lookup table for bytewise CRC32C, LSB first. Generated offline from CRC32C_POLYNOM
+static const uint32_t crc32cTable[256] = {
+    0x00000000, 0xF26B8303, 0xE13B70F7, 0x1350F3F4, 0xC79A971F, 0x35F1141C, 0x26A1E7E8, 0xD4CA64EB,
+    0x8AD958CF, 0x78B2DBCC, 0x6BE22838, 0x9989AB3B, 0x4D43CFD0, 0xBF284CD3, 0xAC78BF27, 0x5E133C24,
+    0x105EC76F, 0xE235446C, 0xF165B798, 0x030E349B, 0xD7C45070, 0x25AFD373, 0x36FF2087, 0xC494A384,
+    0x9A879FA0, 0x68EC1CA3, 0x7BBCEF57, 0x89D76C54, 0x5D1D08BF, 0xAF768BBC, 0xBC267848, 0x4E4DFB4B,
+    0x20BD8EDE, 0xD2D60DDD, 0xC186FE29, 0x33ED7D2A, 0xE72719C1, 0x154C9AC2, 0x061C6936, 0xF477EA35,
+    0xAA64D611, 0x580F5512, 0x4B5FA6E6, 0xB93425E5, 0x6DFE410E, 0x9F95C20D, 0x8CC531F9, 0x7EAEB2FA,
+    0x30E349B1, 0xC288CAB2, 0xD1D83946, 0x23B3BA45, 0xF779DEAE, 0x05125DAD, 0x1642AE59, 0xE4292D5A,
+    0xBA3A117E, 0x4851927D, 0x5B016189, 0xA96AE28A, 0x7DA08661, 0x8FCB0562, 0x9C9BF696, 0x6EF07595,
+    0x417B1DBC, 0xB3109EBF, 0xA0406D4B, 0x522BEE48, 0x86E18AA3, 0x748A09A0, 0x67DAFA54, 0x95B17957,
+    0xCBA24573, 0x39C9C670, 0x2A993584, 0xD8F2B687, 0x0C38D26C, 0xFE53516F, 0xED03A29B, 0x1F682198,
+    0x5125DAD3, 0xA34E59D0, 0xB01EAA24, 0x42752927, 0x96BF4DCC, 0x64D4CECF, 0x77843D3B, 0x85EFBE38,
+    0xDBFC821C, 0x2997011F, 0x3AC7F2EB, 0xC8AC71E8, 0x1C661503, 0xEE0D9600, 0xFD5D65F4, 0x0F36E6F7,
+    0x61C69362, 0x93AD1061, 0x80FDE395, 0x72966096, 0xA65C047D, 0x5437877E, 0x4767748A, 0xB50CF789,
+    0xEB1FCBAD, 0x197448AE, 0x0A24BB5A, 0xF84F3859, 0x2C855CB2, 0xDEEEDFB1, 0xCDBE2C45, 0x3FD5AF46,
+    0x7198540D, 0x83F3D70E, 0x90A324FA, 0x62C8A7F9, 0xB602C312, 0x44694011, 0x5739B3E5, 0xA55230E6,
+    0xFB410CC2, 0x092A8FC1, 0x1A7A7C35, 0xE811FF36, 0x3CDB9BDD, 0xCEB018DE, 0xDDE0EB2A, 0x2F8B6829,
+    0x82F63B78, 0x709DB87B, 0x63CD4B8F, 0x91A6C88C, 0x456CAC67, 0xB7072F64, 0xA457DC90, 0x563C5F93,
+    0x082F63B7, 0xFA44E0B4, 0xE9141340, 0x1B7F9043, 0xCFB5F4A8, 0x3DDE77AB, 0x2E8E845F, 0xDCE5075C,
+    0x92A8FC17, 0x60C37F14, 0x73938CE0, 0x81F80FE3, 0x55326B08, 0xA759E80B, 0xB4091BFF, 0x466298FC,
+    0x1871A4D8, 0xEA1A27DB, 0xF94AD42F, 0x0B21572C, 0xDFEB33C7, 0x2D80B0C4, 0x3ED04330, 0xCCBBC033,
+    0xA24BB5A6, 0x502036A5, 0x4370C551, 0xB11B4652, 0x65D122B9, 0x97BAA1BA, 0x84EA524E, 0x7681D14D,
+    0x2892ED69, 0xDAF96E6A, 0xC9A99D9E, 0x3BC21E9D, 0xEF087A76, 0x1D63F975, 0x0E330A81, 0xFC588982,
+    0xB21572C9, 0x407EF1CA, 0x532E023E, 0xA145813D, 0x758FE5D6, 0x87E466D5, 0x94B49521, 0x66DF1622,
+    0x38CC2A06, 0xCAA7A905, 0xD9F75AF1, 0x2B9CD9F2, 0xFF56BD19, 0x0D3D3E1A, 0x1E6DCDEE, 0xEC064EED,
+    0xC38D26C4, 0x31E6A5C7, 0x22B65633, 0xD0DDD530, 0x0417B1DB, 0xF67C32D8, 0xE52CC12C, 0x1747422F,
+    0x49547E0B, 0xBB3FFD08, 0xA86F0EFC, 0x5A048DFF, 0x8ECEE914, 0x7CA56A17, 0x6FF599E3, 0x9D9E1AE0,
+    0xD3D3E1AB, 0x21B862A8, 0x32E8915C, 0xC083125F, 0x144976B4, 0xE622F5B7, 0xF5720643, 0x07198540,
+    0x590AB964, 0xAB613A67, 0xB831C993, 0x4A5A4A90, 0x9E902E7B, 0x6CFBAD78, 0x7FAB5E8C, 0x8DC0DD8F,
+    0xE330A81A, 0x115B2B19, 0x020BD8ED, 0xF0605BEE, 0x24AA3F05, 0xD6C1BC06, 0xC5914FF2, 0x37FACCF1,
+    0x69E9F0D5, 0x9B8273D6, 0x88D28022, 0x7AB90321, 0xAE7367CA, 0x5C18E4C9, 0x4F48173D, 0xBD23943E,
+    0xF36E6F75, 0x0105EC76, 0x12551F82, 0xE03E9C81, 0x34F4F86A, 0xC69F7B69, 0xD5CF889D, 0x27A40B9E,
+    0x79B737BA, 0x8BDCB4B9, 0x988C474D, 0x6AE7C44E, 0xBE2DA0A5, 0x4C4623A6, 0x5F16D052, 0xAD7D5351
+};
+
+/// lookup table for bytewise CRC32-MPEG2, MSB first. Generated offline from CRC32_MPEG2_POLYNOM
+static const uint32_t mpeg2Table[256] = {
+    0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9, 0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005,
+    0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61, 0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD,
+    0x4C11DB70, 0x48D0C6C7, 0x4593E01E, 0x4152FDA9, 0x5F15ADAC, 0x5BD4B01B, 0x569796C2, 0x52568B75,
+    0x6A1936C8, 0x6ED82B7F, 0x639B0DA6, 0x675A1011, 0x791D4014, 0x7DDC5DA3, 0x709F7B7A, 0x745E66CD,
+    0x9823B6E0, 0x9CE2AB57, 0x91A18D8E, 0x95609039, 0x8B27C03C, 0x8FE6DD8B, 0x82A5FB52, 0x8664E6E5,
+    0xBE2B5B58, 0xBAEA46EF, 0xB7A96036, 0xB3687D81, 0xAD2F2D84, 0xA9EE3033, 0xA4AD16EA, 0xA06C0B5D,
+    0xD4326D90, 0xD0F37027, 0xDDB056FE, 0xD9714B49, 0xC7361B4C, 0xC3F706FB, 0xCEB42022, 0xCA753D95,
+    0xF23A8028, 0xF6FB9D9F, 0xFBB8BB46, 0xFF79A6F1, 0xE13EF6F4, 0xE5FFEB43, 0xE8BCCD9A, 0xEC7DD02D,
+    0x34867077, 0x30476DC0, 0x3D044B19, 0x39C556AE, 0x278206AB, 0x23431B1C, 0x2E003DC5, 0x2AC12072,
+    0x128E9DCF, 0x164F8078, 0x1B0CA6A1, 0x1FCDBB16, 0x018AEB13, 0x054BF6A4, 0x0808D07D, 0x0CC9CDCA,
+    0x7897AB07, 0x7C56B6B0, 0x71159069, 0x75D48DDE, 0x6B93DDDB, 0x6F52C06C, 0x6211E6B5, 0x66D0FB02,
+    0x5E9F46BF, 0x5A5E5B08, 0x571D7DD1, 0x53DC6066, 0x4D9B3063, 0x495A2DD4, 0x44190B0D, 0x40D816BA,
+    0xACA5C697, 0xA864DB20, 0xA527FDF9, 0xA1E6E04E, 0xBFA1B04B, 0xBB60ADFC, 0xB6238B25, 0xB2E29692,
+    0x8AAD2B2F, 0x8E6C3698, 0x832F1041, 0x87EE0DF6, 0x99A95DF3, 0x9D684044, 0x902B669D, 0x94EA7B2A,
+    0xE0B41DE7, 0xE4750050, 0xE9362689, 0xEDF73B3E, 0xF3B06B3B, 0xF771768C, 0xFA325055, 0xFEF34DE2,
+    0xC6BCF05F, 0xC27DEDE8, 0xCF3ECB31, 0xCBFFD686, 0xD5B88683, 0xD1799B34, 0xDC3ABDED, 0xD8FBA05A,
+    0x690CE0EE, 0x6DCDFD59, 0x608EDB80, 0x644FC637, 0x7A089632, 0x7EC98B85, 0x738AAD5C, 0x774BB0EB,
+    0x4F040D56, 0x4BC510E1, 0x46863638, 0x42472B8F, 0x5C007B8A, 0x58C1663D, 0x558240E4, 0x51435D53,
+    0x251D3B9E, 0x21DC2629, 0x2C9F00F0, 0x285E1D47, 0x36194D42, 0x32D850F5, 0x3F9B762C, 0x3B5A6B9B,
+    0x0315D626, 0x07D4CB91, 0x0A97ED48, 0x0E56F0FF, 0x1011A0FA, 0x14D0BD4D, 0x19939B94, 0x1D528623,
+    0xF12F560E, 0xF5EE4BB9, 0xF8AD6D60, 0xFC6C70D7, 0xE22B20D2, 0xE6EA3D65, 0xEBA91BBC, 0xEF68060B,
+    0xD727BBB6, 0xD3E6A601, 0xDEA580D8, 0xDA649D6F, 0xC423CD6A, 0xC0E2D0DD, 0xCDA1F604, 0xC960EBB3,
+    0xBD3E8D7E, 0xB9FF90C9, 0xB4BCB610, 0xB07DABA7, 0xAE3AFBA2, 0xAAFBE615, 0xA7B8C0CC, 0xA379DD7B,
+    0x9B3660C6, 0x9FF77D71, 0x92B45BA8, 0x9675461F, 0x8832161A, 0x8CF30BAD, 0x81B02D74, 0x857130C3,
+    0x5D8A9099, 0x594B8D2E, 0x5408ABF7, 0x50C9B640, 0x4E8EE645, 0x4A4FFBF2, 0x470CDD2B, 0x43CDC09C,
+    0x7B827D21, 0x7F436096, 0x7200464F, 0x76C15BF8, 0x68860BFD, 0x6C47164A, 0x61043093, 0x65C52D24,
+    0x119B4BE9, 0x155A565E, 0x18197087, 0x1CD86D30, 0x029F3D35, 0x065E2082, 0x0B1D065B, 0x0FDC1BEC,
+    0x3793A651, 0x3352BBE6, 0x3E119D3F, 0x3AD08088, 0x2497D08D, 0x2056CD3A, 0x2D15EBE3, 0x29D4F654,
+    0xC5A92679, 0xC1683BCE, 0xCC2B1D17, 0xC8EA00A0, 0xD6AD50A5, 0xD26C4D12, 0xDF2F6BCB, 0xDBEE767C,
+    0xE3A1CBC1, 0xE760D676, 0xEA23F0AF, 0xEEE2ED18, 0xF0A5BD1D, 0xF464A0AA, 0xF9278673, 0xFDE69BC4,
+    0x89B8FD09, 0x8D79E0BE, 0x803AC667, 0x84FBDBD0, 0x9ABC8BD5, 0x9E7D9662, 0x933EB0BB, 0x97FFAD0C,
+    0xAFB010B1, 0xAB710D06, 0xA6322BDF, 0xA2F33668, 0xBCB4666D, 0xB8757BDA, 0xB5365D03, 0xB1F740B4
+};
+
+/// SHA-256 round constants
+static const uint32_t sha256K[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+/// SHA-256 initial hash value
+static const uint32_t sha256Init[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+
+/**********************
+ LOCAL FUNCTIONS
+**********************/
+
+/// @brief update CRC32C register via lookup table. Portable fallback and tail handling for SSE4.2
+/// @param[in]  crc       current CRC register
+/// @param[in]  data      data to add
+/// @param[in]  len       number of bytes to add
+/// @return updated CRC register
+static uint32_t crc32c_table(uint32_t crc, const uint8_t* data, size_t len) {
+
+    for (size_t i = 0; i < len; i++)
+        crc = (crc >> 8) ^ crc32cTable[(crc ^ data[i]) & 0xFF];
+    return crc;
+
+} // crc32c_table()
+
+
+/// @brief process complete SHA-256 message blocks. Portable implementation
+/// @param      hash      hash state
+/// @param[in]  data      message blocks
+/// @param[in]  numBlocks number of 64 byte blocks
+static void sha256_blocks_portable(uint32_t hash[8], const uint8_t* data, size_t numBlocks) {
+
+    #define ROTR(x, n)  (((x) >> (n)) | ((x) << (32 - (n))))
+
+    for (; numBlocks > 0; numBlocks--, data += 64) {
+
+        // message schedule
+        uint32_t w[64];
+        for (int i = 0; i < 16; i++)
+            w[i] = ((uint32_t) data[4*i] << 24) | ((uint32_t) data[4*i+1] << 16) | ((uint32_t) data[4*i+2] << 8) | data[4*i+3];
+        for (int i = 16; i < 64; i++) {
+            uint32_t s0 = ROTR(w[i-15], 7) ^ ROTR(w[i-15], 18) ^ (w[i-15] >> 3);
+            uint32_t s1 = ROTR(w[i-2], 17) ^ ROTR(w[i-2], 19) ^ (w[i-2] >> 10);
+            w[i] = w[i-16] + s0 + w[i-7] + s1;
+        }
+
+        // compression rounds
+        uint32_t a = hash[0], b = hash[1], c = hash[2], d = hash[3];
+        uint32_t e = hash[4], f = hash[5], g = hash[6], h = hash[7];
+        for (int i = 0; i < 64; i++) {
+            uint32_t t1 = h + (ROTR(e, 6) ^ ROTR(e, 11) ^ ROTR(e, 25)) + ((e & f) ^ (~e & g)) + sha256K[i] + w[i];
+            uint32_t t2 = (ROTR(a, 2) ^ ROTR(a, 13) ^ ROTR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;  g = f;  f = e;  e = d + t1;
+            d = c;  c = b;  b = a;  a = t1 + t2;
+        }
+        hash[0] += a;  hash[1] += b;  hash[2] += c;  hash[3] += d;
+        hash[4] += e;  hash[5] += f;  hash[6] += g;  hash[7] += h;
+    }
+
+    #undef ROTR
+
+} // sha256_blocks_portable()
+
+
+#if defined(CHECKSUM_X86)
+
+/// @brief update CRC32C register via SSE4.2 crc32 instruction, 8 bytes per step
+/// @param[in]  crc       current CRC register
+/// @param[in]  data      data to add
+/// @param[in]  len       number of bytes to add
+/// @return updated CRC register
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_sse42(uint32_t crc, const uint8_t* data, size_t len) {
+
+    uint64_t crc64 = crc;
+    size_t   i;
+    for (i = 0; i+8 <= len; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = (uint32_t) crc64;
+    for (; i < len; i++)
+        crc = _mm_crc32_u8(crc, data[i]);
+    return crc;
+
+} // crc32c_sse42()
+
+
+/// @brief process complete SHA-256 message blocks via SHA-NI, 4 rounds per step
+/// @param      hash      hash state
+/// @param[in]  data      message blocks
+/// @param[in]  numBlocks number of 64 byte blocks
+__attribute__((target("sha,ssse3,sse4.1")))
+static void sha256_blocks_shani(uint32_t hash[8], const uint8_t* data, size_t numBlocks) {
+
+    const __m128i swap = _mm_set_epi64x(0x0C0D0E0F08090A0BLL, 0x0405060700010203LL);
+    __m128i       state0, state1, tmp, msg, w[4];
+
+    // reorder hash state to ABEF / CDGH as required by sha256rnds2
+    tmp    = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &hash[0]), 0xB1);
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &hash[4]), 0x1B);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for (; numBlocks > 0; numBlocks--, data += 64) {
+
+        __m128i abefSave = state0;
+        __m128i cdghSave = state1;
+
+        // 16 groups of 4 rounds. Message schedule is calculated 3 groups ahead
+        for (int g = 0; g < 16; g++) {
+            if (g < 4)
+                w[g] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + 16*g)), swap);
+            msg    = _mm_add_epi32(w[g & 3], _mm_loadu_si128((const __m128i*) &sha256K[4*g]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            if ((g >= 3) && (g < 15)) {
+                tmp        = _mm_alignr_epi8(w[g & 3], w[(g-1) & 3], 4);
+                w[(g+1) & 3] = _mm_sha256msg2_epu32(_mm_add_epi32(w[(g+1) & 3], tmp), w[g & 3]);
+            }
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+            if ((g >= 1) && (g < 13))
+                w[(g-1) & 3] = _mm_sha256msg1_epu32(w[(g-1) & 3], w[g & 3]);
+        }
+
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+    }
+
+    // restore order of hash state
+    tmp    = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    _mm_storeu_si128((__m128i*) &hash[0], _mm_blend_epi16(tmp, state1, 0xF0));
+    _mm_storeu_si128((__m128i*) &hash[4], _mm_alignr_epi8(state1, tmp, 8));
+
+} // sha256_blocks_shani()
+
+#endif // CHECKSUM_X86
+
+
+/// @brief get CRC32C update function, depending on CPU features
+/// @return CRC32C update function
+static crc32c_update_t crc32c_get(void) {
+
+    #if defined(CHECKSUM_X86)
+        return (cpuHas(CPU_SSE42)) ? crc32c_sse42 : crc32c_table;
+    #else
+        return crc32c_table;
+    #endif
+
+} // crc32c_get()
+
+
+/// @brief get SHA-256 block function, depending on CPU features
+/// @return SHA-256 block function
+static sha256_blocks_t sha256_get(void) {
+
+    #if defined(CHECKSUM_X86)
+        return (cpuHas(CPU_SHA) && cpuHas(CPU_SSE41)) ? sha256_blocks_shani : sha256_blocks_portable;
+    #else
+        return sha256_blocks_portable;
+    #endif
+
+} // sha256_get()
+
+
+/// @brief apply affine map to CRC register
+/// @param[in]  map       affine map
+/// @param[in]  crc       CRC register
+/// @return mapped CRC register
+static uint32_t crcmap_apply(const CrcMap_s* map, uint32_t crc) {
+
+    uint32_t result = map->b;
+    for (int j = 0; crc != 0; j++, crc >>= 1) {
+        if (crc & 1)
+            result ^= map->col[j];
+    }
+    return result;
+
+} // crcmap_apply()
+
+
+/// @brief square affine map, i.e. apply map twice
+/// @param      map       affine map, is replaced by result
+static void crcmap_square(CrcMap_s* map) {
+
+    CrcMap_s tmp;
+    for (int j = 0; j < 32; j++)
+        tmp.col[j] = crcmap_apply(map, map->col[j]) ^ map->b;
+    tmp.b = crcmap_apply(map, map->b);
+    *map = tmp;
+
+} // crcmap_square()
+
+
+/**********************
+ GLOBAL FUNCTIONS
+**********************/
+
+checksum_t Checksum_getAlgorithm(const char* name) {
+
+    // no name
+    if (name == NULL)
+        return CHECKSUM_UNKNOWN;
+
+    // compare with known names, plus alias
+    for (int i = 0; i < CHECKSUM_UNKNOWN; i++) {
+        if (!strcmp(name, algoName[i]))
+            return (checksum_t) i;
+    }
+    if (!strcmp(name, "crc16-ccitt"))
+        return CHECKSUM_CRC16_CCITT;
+
+    // unsupported algorithm
+    return CHECKSUM_UNKNOWN;
+
+} // Checksum_getAlgorithm()
+
+
+const char* Checksum_getName(const checksum_t algo) {
+
+    return (algo < CHECKSUM_UNKNOWN) ? algoDisplay[algo] : "unknown";
+
+} // Checksum_getName()
+
+
+size_t Checksum_getSize(const checksum_t algo) {
+
+    return (algo < CHECKSUM_UNKNOWN) ? algoSize[algo] : 0;
+
+} // Checksum_getSize()
+
+
+void Checksum_init(Checksum_s* chk, const checksum_t algo) {
+
+    // set initial state
+    chk->algo   = algo;
+    chk->length = 0;
+    if (algo == CHECKSUM_CRC16_CCITT)
+        chk->crc = 0xFFFF;
+    else if (algo == CHECKSUM_ADLER32)
+        chk->crc = 1;
+    else
+        chk->crc = 0xFFFFFFFF;
+    if (algo == CHECKSUM_SHA256)
+        memcpy(chk->hash, sha256Init, sizeof(chk->hash));
+
+} // Checksum_init()
+
+
+void Checksum_update(Checksum_s* chk, const void* data, const size_t len) {
+
+    const uint8_t*  buf = (const uint8_t*) data;
+    uint32_t        crc = chk->crc;
+
+    switch (chk->algo) {
+
+        // CRC32-IEEE via slicing-by-8 or PCLMULQDQ
+        case CHECKSUM_CRC32:
+            crc = crc32_update(crc, buf, len);
+            break;
+
+        // CRC16-CCITT via lookup table
+        case CHECKSUM_CRC16_CCITT:
+            for (size_t i = 0; i < len; i++)
+                crc = ((crc << 8) ^ crc16Table[((crc >> 8) ^ buf[i]) & 0xFF]) & 0xFFFF;
+            break;
+
+        // CRC32C via SSE4.2 or lookup table
+        case CHECKSUM_CRC32C:
+            crc = crc32c_get()(crc, buf, len);
+            break;
+
+        // CRC32-MPEG2 via lookup table
+        case CHECKSUM_CRC32_MPEG2:
+            for (size_t i = 0; i < len; i++)
+                crc = (crc << 8) ^ mpeg2Table[((crc >> 24) ^ buf[i]) & 0xFF];
+            break;
+
+        // Adler-32 with deferred modulo
+        case CHECKSUM_ADLER32: {
+            uint32_t a = crc & 0xFFFF;
+            uint32_t b = crc >> 16;
+            for (size_t i = 0; i < len; ) {
+                size_t end = (len - i < ADLER32_NMAX) ? len : i + ADLER32_NMAX;
+                for (; i < end; i++) {
+                    a += buf[i];
+                    b += a;
+                }
+                a %= ADLER32_BASE;
+                b %= ADLER32_BASE;
+            }
+            crc = (b << 16) | a;
+            break;
+        }
+
+        // SHA-256: complete pending block, then process blocks in place
+        case CHECKSUM_SHA256: {
+            size_t          pending = (size_t) (chk->length & 63);
+            size_t          i = 0;
+            sha256_blocks_t blocks = sha256_get();
+            chk->length += len;
+            if (pending > 0) {
+                i = (len < 64 - pending) ? len : 64 - pending;
+                memcpy(chk->block + pending, buf, i);
+                if (pending + i < 64)
+                    break;
+                blocks(chk->hash, chk->block, 1);
+            }
+            blocks(chk->hash, buf + i, (len - i) / 64);
+            i += (len - i) & ~((size_t) 63);
+            memcpy(chk->block, buf + i, len - i);
+            break;
+        }
+
+        default:
+            break;
+
+    } // switch (algo)
+
+    chk->crc = crc;
+
+} // Checksum_update()
+
+
+void Checksum_fill(Checksum_s* chk, const uint8_t value, const uint64_t len) {
+
+    uint8_t     buf[256];
+    uint64_t    remain = len;
+
+    // CRC: the register update for one constant byte is an affine map. Apply the map N times via
+    // repeated squaring, i.e. O(log N) instead of O(N). Map is derived from the bytewise update
+    if ((len >= CHECKSUM_FILL_MIN) && (chk->algo != CHECKSUM_ADLER32) && (chk->algo != CHECKSUM_SHA256)) {
+        Checksum_s  tmp = *chk;
+        CrcMap_s    map;
+        tmp.crc = 0;
+        Checksum_update(&tmp, &value, 1);
+        map.b = tmp.crc;
+        for (int j = 0; j < 32; j++) {
+            tmp.crc = (j < 8 * (int) algoSize[chk->algo]) ? ((uint32_t) 1 << j) : 0;
+            Checksum_update(&tmp, &value, 1);
+            map.col[j] = tmp.crc ^ map.b;
+        }
+        uint32_t crc = chk->crc;
+        for (uint64_t n = len; n > 0; ) {
+            if (n & 1)
+                crc = crcmap_apply(&map, crc);
+            n >>= 1;
+            if (n > 0)
+                crcmap_square(&map);
+        }
+        chk->crc = crc;
+        return;
+    }
+
+    // Adler-32: closed form for sums over N constant bytes, i.e. A += N*v, B += N*A + v*N*(N+1)/2
+    if (chk->algo == CHECKSUM_ADLER32) {
+        uint64_t a = chk->crc & 0xFFFF;
+        uint64_t b = chk->crc >> 16;
+        uint64_t n = len % ADLER32_BASE;
+        uint64_t m = len % (2 * ADLER32_BASE);
+        b = (b + n * a + value * ((m * (m + 1) / 2) % ADLER32_BASE)) % ADLER32_BASE;
+        a = (a + n * value) % ADLER32_BASE;
+        chk->crc = (uint32_t) ((b << 16) | a);
+        return;
+    }
+
+    // short CRC runs and SHA-256: process constant buffer
+    memset(buf, value, sizeof(buf));
+    while (remain > 0) {
+        size_t num = (remain < sizeof(buf)) ? (size_t) remain : sizeof(buf);
+        Checksum_update(chk, buf, num);
+        remain -= num;
+    }
+
+} // Checksum_fill()
+
+
+void Checksum_final(Checksum_s* chk, uint8_t* digest) {
+
+    uint32_t    value = chk->crc;
+
+    // SHA-256: pad message with 0x80, zeros and message length in bits
+    if (chk->algo == CHECKSUM_SHA256) {
+        uint8_t  pad[72] = { 0x80 };
+        uint64_t bits = chk->length * 8;
+        size_t   lenPad = ((chk->length & 63) < 56) ? 56 - (chk->length & 63) : 120 - (chk->length & 63);
+        for (int i = 0; i < 8; i++)
+            pad[lenPad + i] = (uint8_t) (bits >> (56 - 8*i));
+        Checksum_update(chk, pad, lenPad + 8);
+        for (int i = 0; i < 8; i++) {
+            digest[4*i]   = (uint8_t) (chk->hash[i] >> 24);
+            digest[4*i+1] = (uint8_t) (chk->hash[i] >> 16);
+            digest[4*i+2] = (uint8_t) (chk->hash[i] >> 8);
+            digest[4*i+3] = (uint8_t) (chk->hash[i]);
+        }
+        return;
+    }
+
+    // final XOR for reflected CRC32 variants
+    if ((chk->algo == CHECKSUM_CRC32) || (chk->algo == CHECKSUM_CRC32C))
+        value ^= 0xFFFFFFFF;
+
+    // store CRC or Adler-32 in big-endian order
+    size_t size = Checksum_getSize(chk->algo);
+    for (size_t i = 0; i < size; i++)
+        digest[i] = (uint8_t) (value >> (8 * (size - 1 - i)));
+
+} // Checksum_final()
+
+
+const char* Checksum_toString(const checksum_t algo, const uint8_t* digest, char* str, const size_t lenStr) {
+
+    size_t  size = Checksum_getSize(algo);
+    size_t  pos = 0;
+
+    // CRC or Adler-32 as hex number, hash as plain hex digits (like sha256sum)
+    if (size <= 4)
+        pos += snprintf(str, lenStr, "0x");
+    for (size_t i = 0; (i < size) && (pos + 2 < lenStr); i++)
+        pos += snprintf(str + pos, lenStr - pos, (size <= 4) ? "%02X" : "%02x", digest[i]);
+
+    return str;
+
+} // Checksum_toString()
+
+// end of file
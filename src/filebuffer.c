@@ -0,0 +1,372 @@
+/**
+  \file filebuffer.c
+
+  \author G. Icking-Konert
+
+  \brief implementation of read-only file buffer
+
+  implementation of read-only buffer holding the complete content of a file.
+  Regular files are memory mapped if supported by the OS, else (e.g. for pipes)
+  read in large blocks. File name "-" denotes stdin. Compressed files are decompressed into memory, which
+  requires zlib (HAVE_ZLIB) for gzip and liblzma (HAVE_LZMA) for xz.
+*/
+
+/**********************
+ INCLUDES
+**********************/
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include "filebuffer.h"
+
+// optional decompression of gzip and xz files
+#if defined(HAVE_ZLIB)
+  #include <zlib.h>
+#endif
+#if defined(HAVE_LZMA)
+  #include <lzma.h>
+#endif
+
+// use memory mapping for POSIX systems
+#if defined(__unix__) || defined(__APPLE__)
+  #define FILEBUFFER_MMAP
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+
+/**********************
+ LOCAL FUNCTIONS
+**********************/
+
+/// @brief append data to allocated buffer, expand buffer if required
+/// @param      data      pointer to buffer
+/// @param      size      used size of buffer [B]
+/// @param      capacity  allocated size of buffer [B]
+/// @return pointer to free space of min. FILEBUFFER_BLOCK_SIZE, or NULL on failure
+static uint8_t* FileBuffer_reserve(uint8_t** data, const size_t size, size_t* capacity) {
+
+    // expand buffer by factor 2
+    if (*capacity - size < FILEBUFFER_BLOCK_SIZE) {
+        size_t   newCapacity = (*capacity > 0) ? 2 * (*capacity) : FILEBUFFER_BLOCK_SIZE;
+        uint8_t* newData = (uint8_t*) realloc(*data, newCapacity);
+        if (newData == NULL)
+            return NULL;
+        *data = newData;
+        *capacity = newCapacity;
+    }
+
+    // return pointer to free space
+    return *data + size;
+
+} // FileBuffer_reserve()
+
+
+/// @brief read file content into memory w/o decompression
+/// @param      buf       pointer to file buffer
+/// @param[in]  filename  name of file to read, or "-" for stdin
+/// @return operation successful. On failure errno describes the error
+static bool FileBuffer_read(FileBuffer_s* buf, const char* filename) {
+
+    uint8_t*    data = NULL;
+    size_t      size = 0, capacity = 0;
+
+    // initialize buffer
+    buf->data   = NULL;
+    buf->size   = 0;
+    buf->mapped = false;
+
+    #if defined(FILEBUFFER_MMAP)
+
+        // open file or use stdin
+        bool isStdin = (!strcmp(filename, "-"));
+        int fd = (isStdin) ? STDIN_FILENO : open(filename, O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        // regular non-empty file -> map into memory. Mapping persists after closing file
+        struct stat st;
+        if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)) {
+            void* map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                madvise(map, (size_t) st.st_size, MADV_SEQUENTIAL);
+                if (!isStdin)
+                    close(fd);
+                buf->data   = (const uint8_t*) map;
+                buf->size   = (size_t) st.st_size;
+                buf->mapped = true;
+                return true;
+            }
+        }
+
+        // else (e.g. pipe) read file in large blocks
+        while (true) {
+            uint8_t* block = FileBuffer_reserve(&data, size, &capacity);
+            if (block == NULL) {
+                free(data);
+                if (!isStdin)
+                    close(fd);
+                errno = ENOMEM;
+                return false;
+            }
+            ssize_t num = read(fd, block, capacity - size);
+            if (num < 0) {
+                if (errno == EINTR)
+                    continue;
+                int err = errno;
+                free(data);
+                if (!isStdin)
+                    close(fd);
+                errno = err;
+                return false;
+            }
+            if (num == 0)
+                break;
+            size += (size_t) num;
+        }
+        if (!isStdin)
+            close(fd);
+
+    #else // FILEBUFFER_MMAP
+
+        // open file or use stdin
+        bool isStdin = (!strcmp(filename, "-"));
+        FILE* fp = (isStdin) ? stdin : fopen(filename, "rb");
+        if (fp == NULL)
+            return false;
+
+        // read file in large blocks
+        while (true) {
+            uint8_t* block = FileBuffer_reserve(&data, size, &capacity);
+            if (block == NULL) {
+                free(data);
+                if (!isStdin)
+                    fclose(fp);
+                errno = ENOMEM;
+                return false;
+            }
+            size_t lenBlock = capacity - size;
+            size_t num = fread(block, 1, lenBlock, fp);
+            size += num;
+            if (num < lenBlock) {
+                if (ferror(fp)) {
+                    int err = errno;
+                    free(data);
+                    if (!isStdin)
+                        fclose(fp);
+                    errno = err;
+                    return false;
+                }
+                break;
+            }
+        }
+        if (!isStdin)
+            fclose(fp);
+
+    #endif // FILEBUFFER_MMAP
+
+    // store read content
+    buf->data = data;
+    buf->size = size;
+
+    // return success
+    return true;
+
+} // FileBuffer_read()
+
+
+#if defined(HAVE_ZLIB)
+
+/// @brief decompress gzip file content. Concatenated gzip members are supported
+/// @param[in]  buf       pointer to file buffer with compressed content
+/// @param[out] data      allocated buffer with decompressed content
+/// @param[out] size      size of decompressed content [B]
+/// @return operation successful. On failure errno describes the error
+static bool FileBuffer_inflate(const FileBuffer_s* buf, uint8_t** data, size_t* size) {
+
+    z_stream    strm;
+    size_t      capacity = 0, remaining = buf->size;
+
+    // initialize decompressor for gzip format
+    *data = NULL;
+    *size = 0;
+    memset(&strm, 0, sizeof(strm));
+    if (inflateInit2(&strm, 15+16) != Z_OK) {
+        errno = ENOMEM;
+        return false;
+    }
+    strm.next_in = (Bytef*) buf->data;
+
+    // decompress blockwise into buffer
+    while (true) {
+        uint8_t* block = FileBuffer_reserve(data, *size, &capacity);
+        if (block == NULL) {
+            inflateEnd(&strm);
+            free(*data);
+            errno = ENOMEM;
+            return false;
+        }
+        if (strm.avail_in == 0) {
+            strm.avail_in = (remaining > FILEBUFFER_BLOCK_SIZE) ? FILEBUFFER_BLOCK_SIZE : (uInt) remaining;
+            remaining -= strm.avail_in;
+        }
+        strm.next_out  = block;
+        strm.avail_out = (uInt) FILEBUFFER_BLOCK_SIZE;
+        int result = inflate(&strm, Z_NO_FLUSH);
+        *size += FILEBUFFER_BLOCK_SIZE - strm.avail_out;
+
+        // end of gzip member -> stop at end of file, else continue with next member
+        if (result == Z_STREAM_END) {
+            if ((strm.avail_in == 0) && (remaining == 0))
+                break;
+            inflateReset(&strm);
+        }
+
+        // corrupt or truncated data
+        else if ((result != Z_OK) && ((result != Z_BUF_ERROR) || (remaining == 0))) {
+            inflateEnd(&strm);
+            free(*data);
+            errno = (result == Z_MEM_ERROR) ? ENOMEM : EBADMSG;
+            return false;
+        }
+    }
+    inflateEnd(&strm);
+
+    // return success
+    return true;
+
+} // FileBuffer_inflate()
+
+#endif // HAVE_ZLIB
+
+
+#if defined(HAVE_LZMA)
+
+/// @brief decompress xz file content. Concatenated xz streams are supported
+/// @param[in]  buf       pointer to file buffer with compressed content
+/// @param[out] data      allocated buffer with decompressed content
+/// @param[out] size      size of decompressed content [B]
+/// @return operation successful. On failure errno describes the error
+static bool FileBuffer_unxz(const FileBuffer_s* buf, uint8_t** data, size_t* size) {
+
+    lzma_stream strm = LZMA_STREAM_INIT;
+    size_t      capacity = 0;
+
+    // initialize decompressor for xz format
+    *data = NULL;
+    *size = 0;
+    if (lzma_stream_decoder(&strm, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK) {
+        errno = ENOMEM;
+        return false;
+    }
+    strm.next_in  = buf->data;
+    strm.avail_in = buf->size;
+
+    // decompress blockwise into buffer. Complete input is available -> finish stream
+    while (true) {
+        uint8_t* block = FileBuffer_reserve(data, *size, &capacity);
+        if (block == NULL) {
+            lzma_end(&strm);
+            free(*data);
+            errno = ENOMEM;
+            return false;
+        }
+        strm.next_out  = block;
+        strm.avail_out = FILEBUFFER_BLOCK_SIZE;
+        lzma_ret result = lzma_code(&strm, LZMA_FINISH);
+        *size += FILEBUFFER_BLOCK_SIZE - strm.avail_out;
+        if (result == LZMA_STREAM_END)
+            break;
+        if (result != LZMA_OK) {
+            lzma_end(&strm);
+            free(*data);
+            errno = (result == LZMA_MEM_ERROR) ? ENOMEM : EBADMSG;
+            return false;
+        }
+    }
+    lzma_end(&strm);
+
+    // return success
+    return true;
+
+} // FileBuffer_unxz()
+
+#endif // HAVE_LZMA
+
+
+/**********************
+ GLOBAL FUNCTIONS
+**********************/
+
+bool FileBuffer_open(FileBuffer_s* buf, const char* filename) {
+
+    uint8_t*    data = NULL;
+    size_t      size = 0;
+    bool        result;
+
+    // read file content
+    if (!FileBuffer_read(buf, filename))
+        return false;
+
+    // gzip compressed content (magic bytes 0x1F 0x8B)
+    if ((buf->size >= 2) && (buf->data[0] == 0x1F) && (buf->data[1] == 0x8B)) {
+        #if defined(HAVE_ZLIB)
+            result = FileBuffer_inflate(buf, &data, &size);
+        #else
+            result = false;
+            errno  = ENOTSUP;
+        #endif
+    }
+
+    // xz compressed content (magic bytes 0xFD '7zXZ' 0x00)
+    else if ((buf->size >= 6) && (!memcmp(buf->data, "\xFD" "7zXZ" "\x00", 6))) {
+        #if defined(HAVE_LZMA)
+            result = FileBuffer_unxz(buf, &data, &size);
+        #else
+            result = false;
+            errno  = ENOTSUP;
+        #endif
+    }
+
+    // uncompressed content
+    else
+        return true;
+
+    // replace compressed by decompressed content
+    int err = errno;
+    FileBuffer_close(buf);
+    errno = err;
+    if (!result)
+        return false;
+    buf->data = data;
+    buf->size = size;
+
+    // return success
+    return true;
+
+} // FileBuffer_open()
+
+
+void FileBuffer_close(FileBuffer_s* buf) {
+
+    // release content
+    #if defined(FILEBUFFER_MMAP)
+        if (buf->mapped) {
+            munmap((void*) buf->data, buf->size);
+        }
+        else
+    #endif // FILEBUFFER_MMAP
+    {
+        free((void*) buf->data);
+    }
+
+    // reset struct variables
+    buf->data   = NULL;
+    buf->size   = 0;
+    buf->mapped = false;
+
+} // FileBuffer_close()
+
+// end of file
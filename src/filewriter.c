@@ -0,0 +1,292 @@
+/**
+  \file filewriter.c
+
+  \author G. Icking-Konert
+
+  \brief implementation of output file with optional compression
+
+  implementation of output file which is compressed on the fly depending on the
+  file name suffix, i.e. *.gz (gzip) or *.xz (xz). Compression requires zlib
+  (HAVE_ZLIB) or liblzma (HAVE_LZMA), see Makefile. File name "-" denotes stdout.
+*/
+
+/**********************
+ INCLUDES
+**********************/
+#include <string.h>
+#include <errno.h>
+#include "filewriter.h"
+
+// seek behind end of file for holes in sparse files
+#if defined(__unix__) || defined(__APPLE__)
+  #define FILEWRITER_SEEK
+  #include <sys/types.h>
+#endif
+
+#if defined(HAVE_ZLIB)
+  #include <zlib.h>
+#endif
+#if defined(HAVE_LZMA)
+  #include <lzma.h>
+#endif
+
+
+/**********************
+ LOCAL VARIABLES
+**********************/
+
+/// output stream for file name "-"
+static FILE*    fpStdout = NULL;
+
+
+/**********************
+ LOCAL FUNCTIONS
+**********************/
+
+/// @brief compress data and write compressed data to file
+/// @param      file      pointer to output file
+/// @param[in]  data      data to compress
+/// @param[in]  len       number of bytes to compress
+/// @param[in]  finish    finish compressed stream, i.e. flush all pending data
+/// @return operation successful
+static bool FileWriter_compress(FileWriter_s* file, const void* data, const size_t len, const bool finish) {
+
+    #if defined(HAVE_ZLIB)
+        if (file->compress == COMPRESS_GZIP) {
+            z_stream* strm = (z_stream*) file->stream;
+            strm->next_in  = (Bytef*) data;
+            strm->avail_in = (uInt) len;
+            while (true) {
+                strm->next_out  = file->buf;
+                strm->avail_out = FILEWRITER_BLOCK_SIZE;
+                int result = deflate(strm, finish ? Z_FINISH : Z_NO_FLUSH);
+                if (result == Z_STREAM_ERROR) {
+                    errno = EIO;
+                    return false;
+                }
+                size_t num = FILEWRITER_BLOCK_SIZE - strm->avail_out;
+                if ((num > 0) && (fwrite(file->buf, 1, num, file->fp) != num))
+                    return false;
+                if ((result == Z_STREAM_END) || ((!finish) && (strm->avail_in == 0) && (strm->avail_out > 0)))
+                    return true;
+            }
+        }
+    #endif // HAVE_ZLIB
+
+    #if defined(HAVE_LZMA)
+        if (file->compress == COMPRESS_XZ) {
+            lzma_stream* strm = (lzma_stream*) file->stream;
+            strm->next_in  = (const uint8_t*) data;
+            strm->avail_in = len;
+            while (true) {
+                strm->next_out  = file->buf;
+                strm->avail_out = FILEWRITER_BLOCK_SIZE;
+                lzma_ret result = lzma_code(strm, finish ? LZMA_FINISH : LZMA_RUN);
+                if ((result != LZMA_OK) && (result != LZMA_STREAM_END)) {
+                    errno = (result == LZMA_MEM_ERROR) ? ENOMEM : EIO;
+                    return false;
+                }
+                size_t num = FILEWRITER_BLOCK_SIZE - strm->avail_out;
+                if ((num > 0) && (fwrite(file->buf, 1, num, file->fp) != num))
+                    return false;
+                if ((result == LZMA_STREAM_END) || ((!finish) && (strm->avail_in == 0) && (strm->avail_out > 0)))
+                    return true;
+            }
+        }
+    #endif // HAVE_LZMA
+
+    // compression not supported
+    (void) data;
+    (void) len;
+    (void) finish;
+    errno = ENOTSUP;
+    return false;
+
+} // FileWriter_compress()
+
+
+/// @brief release compressor state and buffers
+/// @param      file      pointer to output file
+static void FileWriter_release(FileWriter_s* file) {
+
+    #if defined(HAVE_ZLIB)
+        if ((file->compress == COMPRESS_GZIP) && (file->stream != NULL))
+            deflateEnd((z_stream*) file->stream);
+    #endif
+    #if defined(HAVE_LZMA)
+        if ((file->compress == COMPRESS_XZ) && (file->stream != NULL))
+            lzma_end((lzma_stream*) file->stream);
+    #endif
+    free(file->stream);
+    free(file->buf);
+    file->stream = NULL;
+    file->buf    = NULL;
+
+} // FileWriter_release()
+
+
+/**********************
+ GLOBAL FUNCTIONS
+**********************/
+
+compress_t FileWriter_getCompression(const char* filename) {
+
+    // check file name suffix
+    size_t len = strlen(filename);
+    if (len >= 3) {
+        const char* suffix = filename + len - 3;
+        if ((!strcmp(suffix, ".gz")) || (!strcmp(suffix, ".GZ")))
+            return COMPRESS_GZIP;
+        if ((!strcmp(suffix, ".xz")) || (!strcmp(suffix, ".XZ")))
+            return COMPRESS_XZ;
+    }
+
+    // no compression
+    return COMPRESS_NONE;
+
+} // FileWriter_getCompression()
+
+
+void FileWriter_setStdout(FILE* fp) {
+
+    fpStdout = fp;
+
+} // FileWriter_setStdout()
+
+
+bool FileWriter_open(FileWriter_s* file, const char* filename) {
+
+    // initialize file
+    file->fp       = NULL;
+    file->compress = FileWriter_getCompression(filename);
+    file->stream   = NULL;
+    file->buf      = NULL;
+    file->sizeHoles = 0;
+
+    // check if compression is supported
+    #if !defined(HAVE_ZLIB)
+        if (file->compress == COMPRESS_GZIP) {
+            errno = ENOTSUP;
+            return false;
+        }
+    #endif
+    #if !defined(HAVE_LZMA)
+        if (file->compress == COMPRESS_XZ) {
+            errno = ENOTSUP;
+            return false;
+        }
+    #endif
+
+    // initialize compressor
+    if (file->compress != COMPRESS_NONE) {
+        file->buf = (uint8_t*) malloc(FILEWRITER_BLOCK_SIZE);
+        bool result = false;
+        #if defined(HAVE_ZLIB)
+            if (file->compress == COMPRESS_GZIP) {
+                z_stream* strm = (z_stream*) calloc(1, sizeof(z_stream));
+                file->stream = strm;
+                result = (strm != NULL) && (deflateInit2(strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15+16, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+            }
+        #endif
+        #if defined(HAVE_LZMA)
+            if (file->compress == COMPRESS_XZ) {
+                lzma_stream* strm = (lzma_stream*) calloc(1, sizeof(lzma_stream));
+                file->stream = strm;
+                result = (strm != NULL) && (lzma_easy_encoder(strm, LZMA_PRESET_DEFAULT, LZMA_CHECK_CRC64) == LZMA_OK);
+            }
+        #endif
+        if ((!result) || (file->buf == NULL)) {
+            FileWriter_release(file);
+            errno = ENOMEM;
+            return false;
+        }
+    }
+
+    // create output file or use stdout
+    if (!strcmp(filename, "-"))
+        file->fp = (fpStdout != NULL) ? fpStdout : stdout;
+    else
+        file->fp = fopen(filename, "wb");
+    if (file->fp == NULL) {
+        int err = errno;
+        FileWriter_release(file);
+        errno = err;
+        return false;
+    }
+
+    // return success
+    return true;
+
+} // FileWriter_open()
+
+
+bool FileWriter_write(FileWriter_s* file, const void* data, const size_t len) {
+
+    // write data w/o compression
+    if (file->compress == COMPRESS_NONE)
+        return (fwrite(data, 1, len, file->fp) == len);
+
+    // compress data and write result
+    return FileWriter_compress(file, data, len, false);
+
+} // FileWriter_write()
+
+
+bool FileWriter_fill(FileWriter_s* file, const uint8_t value, const uint64_t len) {
+
+    // skip zeros in uncompressed file as hole. Not for stdout, which may be a pipe or opened for append
+    #if defined(FILEWRITER_SEEK)
+        bool isStdout = (file->fp == stdout) || (file->fp == fpStdout);
+        if ((value == 0x00) && (file->compress == COMPRESS_NONE) && (!isStdout) && (len > 0) && (len <= INT64_MAX)) {
+            if (fseeko(file->fp, (off_t) len, SEEK_CUR) == 0) {
+                file->sizeHoles += len;
+                return true;
+            }
+        }
+    #endif
+
+    // write fill value in large chunks
+    size_t  lenChunk = (len < FILEWRITER_BLOCK_SIZE) ? (size_t) len : FILEWRITER_BLOCK_SIZE;
+    uint8_t *chunk = (uint8_t*) malloc(lenChunk > 0 ? lenChunk : 1);
+    if (chunk == NULL) {
+        errno = ENOMEM;
+        return false;
+    }
+    memset(chunk, value, lenChunk);
+    bool result = true;
+    for (uint64_t remain = len; (remain > 0) && (result); ) {
+        size_t num = (remain < lenChunk) ? (size_t) remain : lenChunk;
+        result = FileWriter_write(file, chunk, num);
+        remain -= num;
+    }
+    free(chunk);
+    return result;
+
+} // FileWriter_fill()
+
+
+bool FileWriter_close(FileWriter_s* file) {
+
+    bool    result = true;
+
+    // flush compressor
+    if (file->compress != COMPRESS_NONE) {
+        result = FileWriter_compress(file, NULL, 0, true);
+        FileWriter_release(file);
+    }
+
+    // close file. Only flush stdout
+    if ((file->fp == stdout) || (file->fp == fpStdout)) {
+        if (fflush(file->fp) != 0)
+            result = false;
+    }
+    else if (fclose(file->fp) != 0)
+        result = false;
+    file->fp = NULL;
+
+    // return result
+    return result;
+
+} // FileWriter_close()
+
+// end of file
@@ -0,0 +1,198 @@
+/**
+  \file hexdecode.c
+
+  \author G. Icking-Konert
+
+  \brief implementation of fast hex string decoder
+
+  implementation of hex string decoder for S19 and IHX records. Uses SSE2/AVX2
+  on x86 if supported by the CPU, else a portable lookup table decoder.
+*/
+
+/**********************
+ INCLUDES
+**********************/
+#include "hexdecode.h"
+#include "misc.h"
+
+// use SIMD decoder only for x86 and GCC compatible compilers
+#if !defined(HEXDECODE_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+  #define HEXDECODE_X86
+  #include <immintrin.h>
+#endif
+
+
+/**********************
+ LOCAL VARIABLES
+**********************/
+
+/// lookup table for hex decoding, 0x10 | digit value for valid hex characters, else 0x00
+static const uint8_t hexValue[256] = {
+  ['0']=0x10, ['1']=0x11, ['2']=0x12, ['3']=0x13, ['4']=0x14, ['5']=0x15, ['6']=0x16, ['7']=0x17, ['8']=0x18, ['9']=0x19,
+  ['A']=0x1A, ['B']=0x1B, ['C']=0x1C, ['D']=0x1D, ['E']=0x1E, ['F']=0x1F,
+  ['a']=0x1A, ['b']=0x1B, ['c']=0x1C, ['d']=0x1D, ['e']=0x1E, ['f']=0x1F
+};
+
+
+/**********************
+ LOCAL FUNCTIONS
+**********************/
+
+/// @brief decode hex string via lookup table. Portable fallback and tail handling for SIMD decoders
+/// @param[out] data  decoded bytes
+/// @param[in]  str   hex string, 2 characters per byte
+/// @param[in]  len   number of bytes to decode
+/// @param      sum   checksum, decoded bytes are added
+/// @return all characters are valid hex digits. Stops at end of string
+static bool hex_decode_scalar(uint8_t *data, const char *str, const size_t len, uint8_t *sum) {
+
+  uint8_t chk = *sum;
+  for (size_t i = 0; i < len; i++) {
+    uint8_t hi = hexValue[(uint8_t) str[2*i]];
+    if (!hi)
+      return false;
+    uint8_t lo = hexValue[(uint8_t) str[2*i+1]];
+    if (!lo)
+      return false;
+    data[i] = (uint8_t) ((hi << 4) | (lo & 0x0F));
+    chk += data[i];
+  }
+  *sum = chk;
+  return true;
+
+} // hex_decode_scalar()
+
+
+#if defined(HEXDECODE_X86)
+
+/// @brief decode hex string with SSE2, 16 characters per iteration. String length must be checked before
+/// @param[out] data  decoded bytes
+/// @param[in]  str   hex string, 2 characters per byte
+/// @param[in]  len   number of bytes to decode
+/// @param      sum   checksum, decoded bytes are added
+/// @return all characters are valid hex digits
+__attribute__((target("sse2")))
+static bool hex_decode_sse2(uint8_t *data, const char *str, const size_t len, uint8_t *sum) {
+
+  const __m128i zero      = _mm_setzero_si128();
+  const __m128i digitLow  = _mm_set1_epi8('0'-1);
+  const __m128i digitHigh = _mm_set1_epi8('9'+1);
+  const __m128i alphaLow  = _mm_set1_epi8('a'-1);
+  const __m128i alphaHigh = _mm_set1_epi8('f'+1);
+  const __m128i lowerCase = _mm_set1_epi8(0x20);
+  const __m128i maskLow   = _mm_set1_epi16(0x00FF);
+  __m128i       acc       = _mm_setzero_si128();
+  size_t        i;
+
+  for (i = 0; i+8 <= len; i += 8) {
+
+    // load 16 characters and classify. Characters >=0x80 are negative and fail both ranges
+    __m128i c       = _mm_loadu_si128((const __m128i*) (str + 2*i));
+    __m128i lc      = _mm_or_si128(c, lowerCase);
+    __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(c, digitLow), _mm_cmplt_epi8(c, digitHigh));
+    __m128i isAlpha = _mm_and_si128(_mm_cmpgt_epi8(lc, alphaLow), _mm_cmplt_epi8(lc, alphaHigh));
+    if (_mm_movemask_epi8(_mm_or_si128(isDigit, isAlpha)) != 0xFFFF)
+      return false;
+
+    // convert to nibbles: digit -> c-'0', letter -> (c|0x20)-'a'+10
+    __m128i nib = _mm_or_si128(_mm_and_si128(isDigit, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+                               _mm_andnot_si128(isDigit, _mm_sub_epi8(lc, _mm_set1_epi8('a'-10))));
+
+    // combine nibble pairs (even index = upper nibble) and pack to 8 bytes
+    __m128i word  = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nib, maskLow), 4), _mm_srli_epi16(nib, 8));
+    __m128i bytes = _mm_packus_epi16(word, zero);
+    _mm_storel_epi64((__m128i*) (data + i), bytes);
+
+    // accumulate byte sum for checksum
+    acc = _mm_add_epi64(acc, _mm_sad_epu8(bytes, zero));
+  }
+
+  // add vector sum to checksum and decode remaining bytes
+  *sum += (uint8_t) _mm_cvtsi128_si32(acc);
+  return hex_decode_scalar(data + i, str + 2*i, len - i, sum);
+
+} // hex_decode_sse2()
+
+
+/// @brief decode hex string with AVX2, 32 characters per iteration. String length must be checked before
+/// @param[out] data  decoded bytes
+/// @param[in]  str   hex string, 2 characters per byte
+/// @param[in]  len   number of bytes to decode
+/// @param      sum   checksum, decoded bytes are added
+/// @return all characters are valid hex digits
+__attribute__((target("avx2")))
+static bool hex_decode_avx2(uint8_t *data, const char *str, const size_t len, uint8_t *sum) {
+
+  const __m256i zero      = _mm256_setzero_si256();
+  const __m256i digitLow  = _mm256_set1_epi8('0'-1);
+  const __m256i digitHigh = _mm256_set1_epi8('9'+1);
+  const __m256i alphaLow  = _mm256_set1_epi8('a'-1);
+  const __m256i alphaHigh = _mm256_set1_epi8('f'+1);
+  const __m256i lowerCase = _mm256_set1_epi8(0x20);
+  const __m256i maskLow   = _mm256_set1_epi16(0x00FF);
+  __m256i       acc       = _mm256_setzero_si256();
+  size_t        i;
+
+  for (i = 0; i+16 <= len; i += 16) {
+
+    // load 32 characters and classify. Characters >=0x80 are negative and fail both ranges
+    __m256i c       = _mm256_loadu_si256((const __m256i*) (str + 2*i));
+    __m256i lc      = _mm256_or_si256(c, lowerCase);
+    __m256i isDigit = _mm256_and_si256(_mm256_cmpgt_epi8(c, digitLow), _mm256_cmpgt_epi8(digitHigh, c));
+    __m256i isAlpha = _mm256_and_si256(_mm256_cmpgt_epi8(lc, alphaLow), _mm256_cmpgt_epi8(alphaHigh, lc));
+    if (_mm256_movemask_epi8(_mm256_or_si256(isDigit, isAlpha)) != -1)
+      return false;
+
+    // convert to nibbles: digit -> c-'0', letter -> (c|0x20)-'a'+10
+    __m256i nib = _mm256_blendv_epi8(_mm256_sub_epi8(lc, _mm256_set1_epi8('a'-10)), _mm256_sub_epi8(c, _mm256_set1_epi8('0')), isDigit);
+
+    // combine nibble pairs (even index = upper nibble). Packing works per 128-bit lane -> reorder to 16 consecutive bytes
+    __m256i word  = _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(nib, maskLow), 4), _mm256_srli_epi16(nib, 8));
+    __m256i bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(word, zero), 0xD8);
+    _mm_storeu_si128((__m128i*) (data + i), _mm256_castsi256_si128(bytes));
+
+    // accumulate byte sum for checksum
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(bytes, zero));
+  }
+
+  // add vector sum to checksum and decode remaining bytes with SSE2
+  __m128i acc128 = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+  acc128 = _mm_add_epi64(acc128, _mm_unpackhi_epi64(acc128, acc128));
+  *sum += (uint8_t) _mm_cvtsi128_si32(acc128);
+  return hex_decode_sse2(data + i, str + 2*i, len - i, sum);
+
+} // hex_decode_avx2()
+
+#endif // HEXDECODE_X86
+
+
+/**********************
+ GLOBAL FUNCTIONS
+**********************/
+
+bool hex_decode(uint8_t *data, const char *str, const size_t len, uint8_t *sum) {
+
+  #if defined(HEXDECODE_X86)
+
+    // short strings -> use lookup table
+    if (len < 8)
+      return hex_decode_scalar(data, str, len, sum);
+
+    // select decoder by CPU features
+    if (cpuHas(CPU_AVX2))
+      return hex_decode_avx2(data, str, len, sum);
+    else if (cpuHas(CPU_SSE2))
+      return hex_decode_sse2(data, str, len, sum);
+    else
+      return hex_decode_scalar(data, str, len, sum);
+
+  #else
+
+    // portable lookup table decoder
+    return hex_decode_scalar(data, str, len, sum);
+
+  #endif // HEXDECODE_X86
+
+} // hex_decode()
+
+// end of file
@@ -23,22 +23,913 @@
 #include <assert.h>
 #include <errno.h>
 #include "hexfile.h"
+#include "hexdecode.h"
+#include "filebuffer.h"
+#include "filewriter.h"
+#include "crc32.h"
 #include "main.h"
 #include "misc.h"
 
+/**********************
+ LOCAL DEFINES / STRUCTS
+**********************/
+
+/// size of output buffer for file export [B]
+#define OUTBUF_SIZE     (64*1024)
+
+/// buffered output, collects records and writes them to file in large chunks
+typedef struct {
+  FileWriter_s    *file;            //< output file
+  char            data[OUTBUF_SIZE];  //< buffered characters
+  size_t          len;              //< number of buffered characters
+  bool            error;            //< write error occurred
+} OutputBuffer_s;
+
+/// max. number of bytes inspected for format autodetection [B]
+#define DETECT_SIZE         (1024)
+
+/// min. size of file chunks for parallel record parsing [B]. Smaller files are parsed sequentially
+#define IMPORT_CHUNK_MIN    (256*1024)
+
+/// chunk of S19 or IHX file for parallel record parsing
+typedef struct {
+  const char      *data;            //< start of chunk, at line start
+  size_t          size;             //< size of chunk [B]
+  char            format;           //< record format, 'S'=S19 or ':'=IHX
+  int             lineStart;        //< number of lines before chunk
+  int             numLines;         //< number of lines in chunk
+  bool            hasEla;           //< chunk contains IHX extended linear address record
+  uint64_t        addrEla;          //< IHX address offset set by last ELA record in chunk
+  uint64_t        addrOffset;       //< IHX address offset at start of chunk
+  MemoryImage_s   *image;           //< memory image receiving chunk data
+  bool            failed;           //< parsing stopped at first invalid record
+  char            error[IMPORT_ERROR_LEN];  //< error message of first invalid record, incl. line number
+} RecordChunk_s;
+
+/// min. size of data chunks for parallel checksum calculation [B]. Smaller blocks are not split
+#define CHECKSUM_CHUNK_MIN  (1024*1024)
+
+/// chunk of memory block for parallel checksum calculation
+typedef struct {
+  const MemoryImage_s *image;       //< memory image
+  MEMIMAGE_ADDR_T     addrStart;    //< first address of chunk
+  MEMIMAGE_ADDR_T     addrEnd;      //< last address of chunk
+  size_t              idxBlock;     //< index of memory block containing chunk
+  uint32_t            crc;          //< CRC32 checksum of chunk
+} ChecksumChunk_s;
+
+/// worker thread calculating checksums of chunks from a shared list
+typedef struct {
+  ChecksumChunk_s *chunks;          //< list of chunks
+  size_t          numChunks;        //< number of chunks
+  size_t          *next;            //< index of next chunk, shared by all workers
+  checksum_t      algo;             //< checksum_blocks() only: checksum algorithm
+  uint8_t         *digests;         //< checksum_blocks() only: checksums of blocks, CHECKSUM_MAX_SIZE per block
+} ChecksumWorker_s;
+
+/// import of single file into private memory image, for concurrent import of several files
+typedef struct {
+  const ImportFile_s  *file;        //< file to import
+  int                 numThreads;   //< max. number of threads for parsing the file
+  format_t            format;       //< file format, detected for FORMAT_UNKNOWN
+  MemoryImage_s       image;        //< memory image receiving file data
+  bool                failed;       //< import failed, is reported by main thread
+  char                error[IMPORT_ERROR_LEN];  //< error message of failed import
+} ImportTask_s;
+
+/// worker thread importing files from a shared task list
+typedef struct {
+  ImportTask_s    *tasks;           //< list of import tasks
+  int             numTasks;         //< number of import tasks
+  int             *next;            //< index of next task to import, shared by all workers
+} ImportWorker_s;
+
+
+/// lookup table for hex encoding, hexTable[2*i] / hexTable[2*i+1] are upper / lower digit of i
+static const char hexTable[] =
+  "000102030405060708090A0B0C0D0E0F"
+  "101112131415161718191A1B1C1D1E1F"
+  "202122232425262728292A2B2C2D2E2F"
+  "303132333435363738393A3B3C3D3E3F"
+  "404142434445464748494A4B4C4D4E4F"
+  "505152535455565758595A5B5C5D5E5F"
+  "606162636465666768696A6B6C6D6E6F"
+  "707172737475767778797A7B7C7D7E7F"
+  "808182838485868788898A8B8C8D8E8F"
+  "909192939495969798999A9B9C9D9E9F"
+  "A0A1A2A3A4A5A6A7A8A9AAABACADAEAF"
+  "B0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+  "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECF"
+  "D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+  "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEF"
+  "F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+/// names of file formats for console messages (SILENT=none, INFORM=short, CHATTY=long)
+static const char *formatShort[] = { "S19 file", "IHX file", "table", "BIN file", "file" };
+static const char *formatLong[]  = { "Motorola S19 file", "Intel IHX file", "ASCII table file", "binary file", "file" };
+
+
+/**********************
+ LOCAL FUNCTIONS
+**********************/
+
+/// @brief calculate checksums of chunks from shared list until list is exhausted
+/// @param      arg   pointer to checksum worker
+/// @return always NULL
+static void* checksum_worker(void *arg) {
+
+  ChecksumWorker_s  *worker = (ChecksumWorker_s*) arg;
+  size_t            idx;
+
+  // fetch next chunk and calculate checksum
+  while ((idx = __atomic_fetch_add(worker->next, 1, __ATOMIC_RELAXED)) < worker->numChunks) {
+    ChecksumChunk_s *chunk = &(worker->chunks[idx]);
+    chunk->crc = MemoryImage_checksum_crc32(chunk->image, chunk->addrStart, chunk->addrEnd);
+  }
+
+  return NULL;
+
+} // checksum_worker()
+
+
+/// @brief calculate checksums of complete memory blocks from shared list until list is exhausted
+/// @param      arg   pointer to checksum worker
+/// @return always NULL
+static void* digest_worker(void *arg) {
+
+  ChecksumWorker_s  *worker = (ChecksumWorker_s*) arg;
+  Checksum_s        chk;
+  size_t            idx;
+
+  // fetch next block and stream its data through checksum engine
+  while ((idx = __atomic_fetch_add(worker->next, 1, __ATOMIC_RELAXED)) < worker->numChunks) {
+    const MemorySegment_s *segment = &(worker->chunks[idx].image->segments[worker->chunks[idx].idxBlock]);
+    Checksum_init(&chk, worker->algo);
+    Checksum_update(&chk, segment->data, segment->numBytes);
+    Checksum_final(&chk, worker->digests + worker->chunks[idx].idxBlock * CHECKSUM_MAX_SIZE);
+  }
+
+  return NULL;
+
+} // digest_worker()
+
+
+/// @brief initialize output buffer
+/// @param      out   pointer to output buffer
+/// @param[in]  fp    output file
+static void outbuf_init(OutputBuffer_s *out, FileWriter_s *file) {
+  out->file  = file;
+  out->len   = 0;
+  out->error = false;
+} // outbuf_init()
+
+
+/// @brief write buffered characters to file and empty buffer
+/// @param      out   pointer to output buffer
+static void outbuf_flush(OutputBuffer_s *out) {
+  if ((out->len > 0) && (!FileWriter_write(out->file, out->data, out->len)))
+    out->error = true;
+  out->len = 0;
+} // outbuf_flush()
+
+
+/// @brief assert free space in output buffer, flush if required
+/// @param      out   pointer to output buffer
+/// @param[in]  len   required number of characters
+static inline void outbuf_reserve(OutputBuffer_s *out, const size_t len) {
+  if (out->len + len > OUTBUF_SIZE)
+    outbuf_flush(out);
+} // outbuf_reserve()
+
+
+/// @brief append character to output buffer. Space must be reserved before
+/// @param      out   pointer to output buffer
+/// @param[in]  c     character to append
+static inline void outbuf_putc(OutputBuffer_s *out, const char c) {
+  out->data[out->len++] = c;
+} // outbuf_putc()
+
+
+/// @brief append byte as 2 hex digits to output buffer. Space must be reserved before
+/// @param      out   pointer to output buffer
+/// @param[in]  value byte to encode
+static inline void outbuf_puthex(OutputBuffer_s *out, const uint8_t value) {
+  memcpy(out->data + out->len, hexTable + 2*value, 2);
+  out->len += 2;
+} // outbuf_puthex()
+
+
+/// @brief append string to output buffer
+/// @param      out   pointer to output buffer
+/// @param[in]  str   string to append
+static void outbuf_puts(OutputBuffer_s *out, const char *str) {
+  size_t len = strlen(str);
+  outbuf_reserve(out, len);
+  memcpy(out->data + out->len, str, len);
+  out->len += len;
+} // outbuf_puts()
+
+
+/// @brief get next line from buffer. Lines end with '\n', '\r\n' or end of buffer
+/// @param[in]  buf       pointer to buffer
+/// @param[in]  lenBuf    size of buffer
+/// @param      pos       position in buffer, is advanced to start of next line
+/// @param[out] lenLine   length of line w/o line end
+/// @return pointer to line start, or NULL if end of buffer reached
+static const char* next_line(const char *buf, const size_t lenBuf, size_t *pos, size_t *lenLine) {
+
+  // end of buffer reached
+  if (*pos >= lenBuf)
+    return NULL;
+
+  // find end of line
+  const char *line = buf + *pos;
+  const char *end  = (const char*) memchr(line, '\n', lenBuf - *pos);
+  size_t     len   = (end != NULL) ? (size_t) (end - line) : lenBuf - *pos;
+
+  // advance to next line, strip optional '\r'
+  *pos += (end != NULL) ? len+1 : len;
+  if ((len > 0) && (line[len-1] == '\r'))
+    len--;
+  *lenLine = len;
+
+  return line;
+
+} // next_line()
+
+
+/// @brief parse next whitespace separated decimal or hexadecimal (with '0x' prefix) number in line
+/// @param[in]  line      pointer to line
+/// @param[in]  lenLine   length of line
+/// @param      pos       position in line, is advanced behind token
+/// @param[out] value     parsed number
+/// @param[out] valid     token is a valid number, which fits into 64 bit
+/// @return length of token, 0 if no token found. Token starts at line+pos-length
+static size_t next_number(const char *line, const size_t lenLine, size_t *pos, uint64_t *value, bool *valid) {
+
+  uint64_t  num = 0;
+  size_t    start, numDigits = 0;
+  bool      hex = false;
+
+  // skip leading whitespace
+  while ((*pos < lenLine) && isspace((uint8_t) line[*pos]))
+    (*pos)++;
+  start = *pos;
+
+  // check for hex prefix '0x' or '0X'
+  if ((lenLine - start >= 2) && (line[start] == '0') && ((line[start+1] | 0x20) == 'x')) {
+    hex = true;
+    *pos += 2;
+  }
+
+  // convert digits until end of token. Invalid characters only invalidate number
+  *valid = true;
+  while ((*pos < lenLine) && !isspace((uint8_t) line[*pos])) {
+    uint8_t c = (uint8_t) line[*pos];
+    uint8_t digit = (uint8_t) (c - '0');
+    if ((hex) && (digit > 9) && ((uint8_t) ((c | 0x20) - 'a') < 6))
+      digit = (uint8_t) ((c | 0x20) - 'a' + 10);
+    if (digit >= (hex ? 16 : 10))
+      *valid = false;
+    if ((hex) ? (num >> 60) != 0 : num > (UINT64_MAX - digit) / 10)
+      *valid = false;
+    num = (hex) ? (num << 4) | digit : num * 10 + digit;
+    numDigits++;
+    (*pos)++;
+  }
+
+  // require min. 1 digit
+  if (numDigits == 0)
+    *valid = false;
+  *value = num;
+
+  return *pos - start;
+
+} // next_number()
+
+
+/// @brief parse single Motorola S-record and store contained data in memory image
+/// @param[in]  line        record string, not necessarily terminated
+/// @param[in]  lenLine     length of record string w/o line end
+/// @param[in]  linecount   line number for error messages
+/// @param      image       pointer to memory image
+/// @param[out] error       error message for invalid record, IMPORT_ERROR_LEN bytes
+/// @return record is valid
+static bool parse_record_s19(const char *line, const size_t lenLine, const int linecount, MemoryImage_s *image, char *error) {
+
+  uint8_t           rec[256];           // decoded record (length, address, data, checksum)
+  uint8_t           type, lenAddr, len, chkCalc = 0;
+  MEMIMAGE_ADDR_T   address = 0;
+
+  // check 1st char (must be 'S')
+  if ((lenLine < 1) || (line[0] != 'S')) {
+    snprintf(error, IMPORT_ERROR_LEN, "Line %u in Motorola S-record: line does not start with 'S'", linecount);
+    return false;
+  }
+
+  // record type
+  type = (lenLine > 1) ? line[1]-48 : 0;
+
+  // skip if line contains no data, i.e. line doesn't start with S1, S2 or S3
+  if ((type != 1) && (type != 2) && (type != 3))
+    return true;
+  lenAddr = type+1;                     // S1=16bit, S2=24bit, S3=32bit
+
+  // decode record length, then address + data + checksum
+  if ((lenLine < 4) || (!hex_decode(rec, line+2, 1, &chkCalc)) || (rec[0] < lenAddr+1) ||
+      (lenLine < 4 + 2*(size_t) rec[0]) || (!hex_decode(rec+1, line+4, rec[0], &chkCalc))) {
+    snprintf(error, IMPORT_ERROR_LEN, "Line %u in Motorola S-record: invalid hex character or record too short", linecount);
+    return false;
+  }
+  len = rec[0];
+
+  // assert checksum (0xFF xor (sum over all except record type)), i.e. sum including checksum is 0xFF
+  if (chkCalc != 0xFF) {
+    snprintf(error, IMPORT_ERROR_LEN, "Line %u in Motorola S-record: checksum error (0x%02" PRIX8 " vs. 0x%02" PRIX8 ")", linecount, (uint8_t) rec[len], (uint8_t) ((chkCalc - rec[len]) ^ 0xFF));
+    return false;
+  }
+
+  // get address (big endian)
+  for (int i=0; i<lenAddr; i++)
+    address = (address << 8) | rec[1+i];
+
+  // store record data in memory image
+  if ((len > lenAddr+1) && (!MemoryImage_addBlock(image, address, rec+1+lenAddr, len-1-lenAddr))) {
+    snprintf(error, IMPORT_ERROR_LEN, "Line %u in Motorola S-record: out of memory", linecount);
+    return false;
+  }
+
+  return true;
+
+} // parse_record_s19()
+
+
+/// @brief parse single Intel hex record and store contained data in memory image
+/// @param[in]  line        record string, not necessarily terminated
+/// @param[in]  lenLine     length of record string w/o line end
+/// @param[in]  linecount   line number for error messages
+/// @param      addrOffset  address offset from last extended linear address record
+/// @param      image       pointer to memory image
+/// @param[out] error       error message for invalid record, IMPORT_ERROR_LEN bytes
+/// @return record is valid
+static bool parse_record_ihx(const char *line, const size_t lenLine, const int linecount, uint64_t *addrOffset, MemoryImage_s *image, char *error) {
+
+  uint8_t           rec[256+5];         // decoded record (length, address, type, data, checksum)
+  uint8_t           type, len, chkCalc = 0;
+
+  // check 1st char (must be ':')
+  if ((lenLine < 1) || (line[0] != ':')) {
+    snprintf(error, IMPORT_ERROR_LEN, "Line %u in Intel hex record: line does not start with ':'", linecount);
+    return false;
+  }
+
+  // decode record length, 16b address and record type
+  if ((lenLine < 9) || (!hex_decode(rec, line+1, 4, &chkCalc))) {
+    snprintf(error, IMPORT_ERROR_LEN, "Line %u in Intel hex record: invalid hex character or record too short", linecount);
+    return false;
+  }
+  len  = rec[0];
+  type = rec[3];
+
+  // EOF indicator
+  if (type==1)
+    return true;
+
+  // extended segment addresses not yet supported
+  else if (type==2) {
+    snprintf(error, IMPORT_ERROR_LEN, "Line %u in Intel hex record: extended segment address type 2 not supported", linecount);
+    return false;
+  }
+
+  // start segment address (only relevant for 80x86 processor, ignore here)
+  else if (type==3)
+    return true;
+
+  // start linear address records. Can be ignored, see http://www.keil.com/support/docs/1584/
+  else if (type==5)
+    return true;
+
+  // extended address must contain 2B
+  else if ((type==4) && (len!=2)) {
+    snprintf(error, IMPORT_ERROR_LEN, "Line %u in Intel hex record: extended address requires 2B (is %dB)", linecount, len);
+    return false;
+  }
+
+  // unsupported record type -> error
+  else if ((type!=0) && (type!=4)) {
+    snprintf(error, IMPORT_ERROR_LEN, "Line %u in Intel hex record: unsupported type %d", linecount, type);
+    return false;
+  }
+
+  // decode data + checksum
+  if ((lenLine < 9 + 2*((size_t) len+1)) || (!hex_decode(rec+4, line+9, len+1, &chkCalc))) {
+    snprintf(error, IMPORT_ERROR_LEN, "Line %u in Intel hex record: invalid hex character or record too short", linecount);
+    return false;
+  }
+
+  // assert checksum (2-complement of sum over all), i.e. sum including checksum is 0x00
+  if (chkCalc != 0x00) {
+    snprintf(error, IMPORT_ERROR_LEN, "Line %u in Intel hex record: checksum error (0x%02" PRIX8 " vs. 0x%02" PRIX8 ")", linecount, (uint8_t) rec[4+len], (uint8_t) (rec[4+len] - chkCalc));
+    return false;
+  }
+
+  // record contains data -> store in memory image. Add offset for >64kB addresses
+  if (type==0) {
+    if ((len > 0) && (!MemoryImage_addBlock(image, (MEMIMAGE_ADDR_T) (((uint64_t) rec[1] << 8) + rec[2] + *addrOffset), rec+4, len))) {
+      snprintf(error, IMPORT_ERROR_LEN, "Line %u in Intel hex record: out of memory", linecount);
+      return false;
+    }
+  }
+
+  // extended address (=upper 16b of address for following data records)
+  else {
+    *addrOffset = (((uint64_t) rec[4] << 8) | rec[5]) << 16;
+  }
+
+  return true;
+
+} // parse_record_ihx()
+
+
+/// @brief count lines of record chunk and get last IHX extended linear address (ELA)
+/// @param      arg   pointer to record chunk
+/// @return always NULL
+static void* prescan_chunk(void *arg) {
+
+  RecordChunk_s *chunk = (RecordChunk_s*) arg;
+  const char    *line;
+  size_t        lenLine, pos = 0;
+
+  // loop over lines in chunk
+  while ((line = next_line(chunk->data, chunk->size, &pos, &lenLine)) != NULL) {
+
+    // increase line counter
+    chunk->numLines++;
+
+    // IHX extended linear address record -> store upper 16b of address. Record errors are reported during parsing
+    if ((chunk->format == ':') && (lenLine >= 13) && (line[0] == ':') && (line[7] == '0') && (line[8] == '4')) {
+      uint8_t addr[2], chk = 0;
+      if (hex_decode(addr, line+9, 2, &chk)) {
+        chunk->hasEla  = true;
+        chunk->addrEla = (((uint64_t) addr[0] << 8) | addr[1]) << 16;
+      }
+    }
+
+  } // loop over lines
+
+  return NULL;
+
+} // prescan_chunk()
+
+
+/// @brief parse records in chunk and store data in chunk memory image. Stops at first invalid record
+/// @param      arg   pointer to record chunk
+/// @return always NULL
+static void* parse_chunk(void *arg) {
+
+  RecordChunk_s *chunk = (RecordChunk_s*) arg;
+  const char    *line;
+  size_t        lenLine, pos = 0;
+  int           linecount  = chunk->lineStart;
+  uint64_t      addrOffset = chunk->addrOffset;
+
+  // loop over lines in chunk
+  while ((line = next_line(chunk->data, chunk->size, &pos, &lenLine)) != NULL) {
+
+    // increase line counter
+    linecount++;
+
+    // decode record and store data in memory image. On error stop chunk, is reported by caller
+    bool valid;
+    if (chunk->format == 'S')
+      valid = parse_record_s19(line, lenLine, linecount, chunk->image, chunk->error);
+    else
+      valid = parse_record_ihx(line, lenLine, linecount, &addrOffset, chunk->image, chunk->error);
+    if (!valid) {
+      chunk->failed = true;
+      break;
+    }
+
+  } // loop over lines
+
+  return NULL;
+
+} // parse_chunk()
+
+
+/// @brief parse S19 or IHX records in file and store data in memory image. Large files are split into chunks which are parsed in parallel
+/// @param[in]  file        file content
+/// @param[in]  format      record format, 'S'=S19 or ':'=IHX
+/// @param[in]  numThreads  max. number of parallel threads
+/// @param      image       pointer to memory image
+/// @param[out] error       error message on failure, IMPORT_ERROR_LEN bytes
+/// @return all records valid. On failure the first invalid record in file is reported
+static bool parse_records(const FileBuffer_s *file, const char format, const int numThreads, MemoryImage_s *image, char *error) {
+
+  RecordChunk_s   *chunks = NULL;       // file chunks
+  MemoryImage_s   *images = NULL;       // memory images of chunks
+  const MemoryImage_s **list = NULL;    // list of images to merge
+
+  // number of chunks, limited by file size
+  int numChunks = numThreads;
+  if ((uint64_t) numChunks > file->size / IMPORT_CHUNK_MIN)
+    numChunks = (int) (file->size / IMPORT_CHUNK_MIN);
+
+  // allocate chunk buffers
+  if (numChunks > 1) {
+    chunks = (RecordChunk_s*) calloc(numChunks, sizeof(RecordChunk_s));
+    images = (MemoryImage_s*) calloc(numChunks, sizeof(MemoryImage_s));
+    list   = (const MemoryImage_s**) calloc(numChunks+1, sizeof(MemoryImage_s*));
+  }
+
+  // small file or allocation failed -> parse sequentially into image
+  if ((chunks == NULL) || (images == NULL) || (list == NULL)) {
+    RecordChunk_s chunk = { .data = (const char*) file->data, .size = file->size, .format = format, .image = image };
+    parse_chunk(&chunk);
+    free(chunks);
+    free(images);
+    free(list);
+    if (chunk.failed)
+      memcpy(error, chunk.error, IMPORT_ERROR_LEN);
+    return !chunk.failed;
+  }
+
+  // split file into chunks of similar size at line boundaries
+  const char *data = (const char*) file->data;
+  size_t     start = 0;
+  for (int i = 0; i < numChunks; i++) {
+    size_t end = file->size;
+    if (i < numChunks-1) {
+      end = (i+1) * (file->size / numChunks);
+      if (end < start)
+        end = start;
+      const char *eol = (const char*) memchr(data + end, '\n', file->size - end);
+      end = (eol != NULL) ? (size_t) (eol - data) + 1 : file->size;
+    }
+    MemoryImage_init(&(images[i]));
+    chunks[i].data   = data + start;
+    chunks[i].size   = end - start;
+    chunks[i].format = format;
+    chunks[i].image  = &(images[i]);
+    start = end;
+  }
+
+  // count lines and find IHX extended addresses in parallel
+  runParallel(prescan_chunk, chunks, sizeof(RecordChunk_s), numChunks);
+
+  // propagate line numbers and IHX address offsets in file order
+  for (int i = 1; i < numChunks; i++) {
+    chunks[i].lineStart  = chunks[i-1].lineStart + chunks[i-1].numLines;
+    chunks[i].addrOffset = (chunks[i-1].hasEla) ? chunks[i-1].addrEla : chunks[i-1].addrOffset;
+  }
+
+  // parse chunks in parallel
+  runParallel(parse_chunk, chunks, sizeof(RecordChunk_s), numChunks);
+
+  // report first invalid record in file order, i.e. from lowest failing chunk
+  for (int i = 0; i < numChunks; i++) {
+    if (chunks[i].failed) {
+      memcpy(error, chunks[i].error, IMPORT_ERROR_LEN);
+      for (int j = 0; j < numChunks; j++)
+        MemoryImage_free(&(images[j]));
+      free(chunks);
+      free(images);
+      free(list);
+      return false;
+    }
+  }
+
+  // merge chunks in file order, i.e. later records overwrite earlier ones
+  list[0] = image;
+  for (int i = 0; i < numChunks; i++)
+    list[i+1] = &(images[i]);
+  bool result = MemoryImage_mergeImages(list, numChunks+1, image);
+
+  // release chunk buffers
+  for (int i = 0; i < numChunks; i++)
+    MemoryImage_free(&(images[i]));
+  free(chunks);
+  free(images);
+  free(list);
+
+  // check merge result
+  if (!result)
+    snprintf(error, IMPORT_ERROR_LEN, "Failed to merge file chunks");
+  return result;
+
+} // parse_records()
+
+
+/// @brief parse plain text table (address / value) and store data in memory image
+/// @param[in]  buf         table buffer, not necessarily terminated
+/// @param[in]  lenBuf      size of buffer [B]
+/// @param      image       pointer to memory image
+/// @param[out] error       error message on failure, IMPORT_ERROR_LEN bytes
+/// @return all lines valid
+static bool parse_table(const char *buf, const size_t lenBuf, MemoryImage_s *image, char *error) {
+
+  const char      *line;
+  size_t          lenLine, pos = 0, posLine, lenAddr, lenValue;
+  int             linecount  = 0;
+  uint64_t        address, value;
+  bool            validAddr, validValue;
+  MemoryStaging_s staging;              // buffer for unsorted data
+
+  // collect data in staging buffer, add to image after import
+  MemoryStaging_init(&staging);
+
+  // read data line by line
+  while ((line = next_line(buf, lenBuf, &pos, &lenLine)) != NULL) {
+
+    // increase line counter
+    linecount++;
+
+    // get address. Skip empty lines and comments starting with '#'
+    posLine = 0;
+    lenAddr = next_number(line, lenLine, &posLine, &address, &validAddr);
+    if ((lenAddr == 0) || (line[posLine-lenAddr] == '#'))
+      continue;
+    if ((!validAddr) || ((MEMIMAGE_ADDR_T) address != address)) {
+      MemoryStaging_free(&staging);
+      snprintf(error, IMPORT_ERROR_LEN, "Line %u in table: invalid address '%.*s'", linecount, (int) lenAddr, line+posLine-lenAddr);
+      return false;
+    }
+
+    // get value. Further columns are ignored
+    lenValue = next_number(line, lenLine, &posLine, &value, &validValue);
+    if (lenValue == 0) {
+      MemoryStaging_free(&staging);
+      snprintf(error, IMPORT_ERROR_LEN, "Line %u in table: missing value", linecount);
+      return false;
+    }
+    if ((!validValue) || (value > 0xFF)) {
+      MemoryStaging_free(&staging);
+      snprintf(error, IMPORT_ERROR_LEN, "Line %u in table: invalid value '%.*s'", linecount, (int) lenValue, line+posLine-lenValue);
+      return false;
+    }
+
+    // store data byte in staging buffer
+    if (!MemoryStaging_addData(&staging, (MEMIMAGE_ADDR_T) address, (uint8_t) value)) {
+      MemoryStaging_free(&staging);
+      snprintf(error, IMPORT_ERROR_LEN, "Line %u in table: out of memory", linecount);
+      return false;
+    }
+
+  } // while !EOF
+
+  // sort staged data and add to memory image. Staging buffer is released in any case
+  if (!MemoryStaging_commit(&staging, image)) {
+    snprintf(error, IMPORT_ERROR_LEN, "Failed to add table data to image");
+    return false;
+  }
+
+  return true;
+
+} // parse_table()
+
+
+/// @brief store slice of binary file in memory image
+/// @param[in]  file        file content
+/// @param[in]  filename    name of file for error messages
+/// @param[in]  addrStart   address offset for binary import
+/// @param[in]  offset      first byte in file to import
+/// @param[in]  length      number of bytes to import, or 0 for remainder of file
+/// @param      image       pointer to memory image
+/// @param[out] error       error message on failure, IMPORT_ERROR_LEN bytes
+/// @return slice is inside file and was stored
+static bool import_slice(const FileBuffer_s *file, const char *filename, const MEMIMAGE_ADDR_T addrStart, const uint64_t offset, const uint64_t length, MemoryImage_s *image, char *error) {
+
+  // check requested slice
+  uint64_t size = (uint64_t) file->size;
+  if ((offset > size) || (length > size - offset)) {
+    snprintf(error, IMPORT_ERROR_LEN, "Offset 0x%" PRIX64 " + length 0x%" PRIX64 " exceeds size of file %s (0x%" PRIX64 ")", offset, length, filename, size);
+    return false;
+  }
+  uint64_t lenSlice = (length == 0) ? size - offset : length;
+
+  // store slice as single block in memory image
+  if ((lenSlice > 0) && (!MemoryImage_addBlock(image, addrStart, file->data + offset, (size_t) lenSlice))) {
+    snprintf(error, IMPORT_ERROR_LEN, "Failed to store slice 0x%" PRIX64 " + 0x%" PRIX64 " of file %s", offset, lenSlice, filename);
+    return false;
+  }
+
+  return true;
+
+} // import_slice()
+
+
+/// @brief parse file content depending on file format
+/// @param[in]  file        file content
+/// @param[in]  format      file format, not FORMAT_UNKNOWN
+/// @param[in]  filename    name of file for error messages
+/// @param[in]  addrStart   binary only: address offset
+/// @param[in]  offset      binary only: first byte in file to import
+/// @param[in]  length      binary only: number of bytes to import, or 0 for remainder of file
+/// @param[in]  numThreads  max. number of threads for parsing large files
+/// @param      image       pointer to memory image
+/// @param[out] error       error message on failure, IMPORT_ERROR_LEN bytes
+/// @return file content valid
+static bool parse_file(const FileBuffer_s *file, const format_t format, const char *filename, const MEMIMAGE_ADDR_T addrStart, const uint64_t offset, const uint64_t length, const int numThreads, MemoryImage_s *image, char *error) {
+
+  if (format == FORMAT_S19)
+    return parse_records(file, 'S', numThreads, image, error);
+  else if (format == FORMAT_IHX)
+    return parse_records(file, ':', numThreads, image, error);
+  else if (format == FORMAT_TXT)
+    return parse_table((const char*) file->data, file->size, image, error);
+  else
+    return import_slice(file, filename, addrStart, offset, length, image, error);
+
+} // parse_file()
+
+
+/// @brief read file into memory image, depending on file format
+/// @param[in]  file        file to import
+/// @param      image       pointer to memory image
+/// @param[in]  numThreads  max. number of threads for parsing large files
+/// @param[in]  verbose     verbosity level (0=MUTE, 1=SILENT, 2=INFORM, 3=CHATTY)
+/// @return file format, detected for FORMAT_UNKNOWN
+static format_t import_file(const ImportFile_s *file, MemoryImage_s *image, const int numThreads, const uint8_t verbose) {
+
+  if (file->format == FORMAT_S19)
+    import_file_s19(file->filename, image, numThreads, verbose);
+  else if (file->format == FORMAT_IHX)
+    import_file_ihx(file->filename, image, numThreads, verbose);
+  else if (file->format == FORMAT_TXT)
+    import_file_txt(file->filename, image, verbose);
+  else if (file->format == FORMAT_BIN)
+    import_file_bin(file->filename, file->addrStart, file->offset, file->length, image, verbose);
+  else
+    return import_file_auto(file->filename, file->addrStart, file->offset, file->length, image, numThreads, verbose);
+
+  return file->format;
+
+} // import_file()
+
+
+/// @brief import single file into private image w/o console output. Errors are stored in task
+/// @param      task  pointer to import task
+static void import_task(ImportTask_s *task) {
+
+  const ImportFile_s  *params = task->file;
+  FileBuffer_s        file;
+
+  // open file to read
+  if (!FileBuffer_open(&file, params->filename)) {
+    snprintf(task->error, IMPORT_ERROR_LEN, "Failed to open file %s with error [%s]", params->filename, strerror(errno));
+    task->failed = true;
+    return;
+  }
+
+  // get format from extension or file content, then parse content
+  task->format = (params->format != FORMAT_UNKNOWN) ? params->format : detect_format(file.data, file.size);
+  if (!parse_file(&file, task->format, params->filename, params->addrStart, params->offset, params->length, task->numThreads, &(task->image), task->error))
+    task->failed = true;
+
+  // close file again
+  FileBuffer_close(&file);
+
+} // import_task()
+
+
+/// @brief import files from shared task list into private images until list is exhausted
+/// @param      arg   pointer to import worker
+/// @return always NULL
+static void* import_worker(void *arg) {
+
+  ImportWorker_s  *worker = (ImportWorker_s*) arg;
+  int             idx;
+
+  // fetch next task and import file w/o console output
+  while ((idx = __atomic_fetch_add(worker->next, 1, __ATOMIC_RELAXED)) < worker->numTasks)
+    import_task(&(worker->tasks[idx]));
+
+  return NULL;
+
+} // import_worker()
+
+
 /**
-  \fn void import_file_s19(const char *filename, MemoryImage_s *image, const uint8_t verbose)
+  \fn format_t get_format(const char *name)
 
-  \param[in]  filename    full name of file to read 
+  \param[in]  name        file extension (e.g. ".s19") or format name (e.g. "s19"). May be NULL
+
+  \return file format, or FORMAT_UNKNOWN if not supported
+
+  Get file format from file extension or format name, e.g. for option '-format'
+*/
+format_t get_format(const char *name) {
+
+  // no name
+  if (name == NULL)
+    return FORMAT_UNKNOWN;
+
+  // skip optional '.' of extension
+  if (name[0] == '.')
+    name++;
+
+  // get format from name
+  if ((!strcmp(name, "s19")) || (!strcmp(name, "S19")))                                                         // Motorola S-record format
+    return FORMAT_S19;
+  else if ((!strcmp(name, "hex")) || (!strcmp(name, "HEX")) || (!strcmp(name, "ihx")) || (!strcmp(name, "IHX")))  // Intel hex format
+    return FORMAT_IHX;
+  else if ((!strcmp(name, "txt")) || (!strcmp(name, "TXT")))                                                    // text table (hex addr / data)
+    return FORMAT_TXT;
+  else if ((!strcmp(name, "bin")) || (!strcmp(name, "BIN")))                                                    // binary file
+    return FORMAT_BIN;
+
+  // unsupported format
+  return FORMAT_UNKNOWN;
+
+} // get_format()
+
+
+
+/**
+  \fn format_t detect_format(const uint8_t *buf, const size_t lenBuf)
+
+  \param[in]  buf         file content. Is not modified and need not be NUL terminated
+  \param[in]  lenBuf      size of buffer [B]
+
+  \return detected file format (FORMAT_S19, FORMAT_IHX, FORMAT_TXT or FORMAT_BIN)
+
+  Detect file format from the first DETECT_SIZE bytes of the file content. Text starting
+  with an S-record ('S0'..'S9') is S19, with ':' and hex digits is IHX, and lines with
+  two numbers (or '#' comments) are a table. Anything else is treated as binary.
+*/
+format_t detect_format(const uint8_t *buf, const size_t lenBuf) {
+
+  const char  *text = (const char*) buf;
+  const char  *line;
+  size_t      lenLine, pos = 0, posLine, lenToken;
+  uint64_t    value;
+  bool        valid;
+  int         numLines = 0;           // number of table lines
+
+  // inspect only start of buffer
+  size_t len = (lenBuf < DETECT_SIZE) ? lenBuf : DETECT_SIZE;
+
+  // empty or non-text characters -> binary
+  if (len == 0)
+    return FORMAT_BIN;
+  for (size_t i = 0; i < len; i++) {
+    uint8_t c = buf[i];
+    if (((c < 0x20) || (c > 0x7E)) && (c != '\t') && (c != '\r') && (c != '\n'))
+      return FORMAT_BIN;
+  }
+
+  // check lines in inspected range
+  while ((line = next_line(text, len, &pos, &lenLine)) != NULL) {
+
+    // skip empty lines
+    posLine  = 0;
+    lenToken = next_number(line, lenLine, &posLine, &value, &valid);
+    if (lenToken == 0)
+      continue;
+
+    // first record identifies S19 or IHX
+    if (numLines == 0) {
+      if ((lenLine >= 2) && (line[0] == 'S') && (isdigit((uint8_t) line[1])))
+        return FORMAT_S19;
+      if ((lenLine >= 3) && (line[0] == ':') && (isxdigit((uint8_t) line[1])) && (isxdigit((uint8_t) line[2])))
+        return FORMAT_IHX;
+    }
+
+    // last line may be truncated -> don't check
+    if ((len < lenBuf) && (text[pos-1] != '\n'))
+      break;
+
+    // table line is comment or address and value
+    if (line[posLine-lenToken] != '#') {
+      if ((!valid) || (next_number(line, lenLine, &posLine, &value, &valid) == 0) || (!valid))
+        return FORMAT_BIN;
+    }
+    numLines++;
+
+  } // loop over lines
+
+  // valid table lines found -> table, else binary
+  return (numLines > 0) ? FORMAT_TXT : FORMAT_BIN;
+
+} // detect_format()
+
+
+
+/**
+  \fn void import_file_s19(const char *filename, MemoryImage_s *image, const int numThreads, const uint8_t verbose)
+
+  \param[in]  filename    full name of file to read, or "-" for stdin
   \param      image       pointer to memory image. Must be initialized. Existing content is overwritten
+  \param[in]  numThreads  max. number of threads for parsing large files
   \param[in]  verbose     verbosity level (0=MUTE, 1=SILENT, 2=INFORM, 3=CHATTY)
 
   Read Motorola s19 hexfile into memory image. For description of
   Motorola S19 file format see http://en.wikipedia.org/wiki/SREC_(file_format)
 */
-void import_file_s19(const char *filename, MemoryImage_s *image, const uint8_t verbose) {
+void import_file_s19(const char *filename, MemoryImage_s *image, const int numThreads, const uint8_t verbose) {
 
-  FILE      *fp;
+  FileBuffer_s  file;                 // file content
+  char          error[IMPORT_ERROR_LEN];  // error message from parsing
 
   // strip path from filename for readability
   #if defined(WIN32)
@@ -61,7 +952,7 @@ void import_file_s19(const char *filename, MemoryImage_s *image, const uint8_t v
   fflush(stdout);
 
   // open file to read
-  if (!(fp = fopen(filename, "rb"))) {
+  if (!FileBuffer_open(&file, filename)) {
     MemoryImage_free(image);
     Error("Failed to open file %s with error [%s]", filename, strerror(errno));
   }
@@ -71,81 +962,12 @@ void import_file_s19(const char *filename, MemoryImage_s *image, const uint8_t v
   // start data import
   //=====================
 
-  char              line[STRLEN], tmp[STRLEN];
-  int               linecount = 0, idx, len;
-  uint8_t           type, chkRead, chkCalc;
-  MEMIMAGE_ADDR_T   address = 0; 
-  int               value = 0;
-
-  // read data line by line
-  while (fgets(line, STRLEN, fp)) {
-
-    // increase line counter
-    linecount++;
-
-    // check 1st char (must be 'S')
-    if (line[0] != 'S') {
-      MemoryImage_free(image);
-      Error("Line %u in Motorola S-record: line does not start with 'S'", linecount);
-    }
-
-    // record type
-    type = line[1]-48;
-
-    // skip if line contains no data, i.e. line doesn't start with S1, S2 or S3
-    if ((type != 1) && (type != 2) && (type != 3))
-      continue;
-
-    // record length (address + data + checksum)
-    sprintf(tmp,"0x00");
-    strncpy(tmp+2, line+2, 2);
-    sscanf(tmp, "%x", &value);
-    len = value;
-    chkCalc = value;
-
-    // address (S1=16bit, S2=24bit, S3=32bit)
-    address = 0;
-    for (int i=0; i<type+1; i++) {
-      sprintf(tmp,"0x00");
-      tmp[2] = line[4+(i*2)];
-      tmp[3] = line[5+(i*2)];
-      sscanf(tmp, "%x", &value);
-      address *= (uint64_t) 256;
-      address += (uint64_t) value;
-      chkCalc += (uint8_t) value;
-    }
-
-    // read record data
-    idx = 6+(type*2);                   // start at position 8, 10, or 12, depending on record type
-    len = len-1-(1+type);               // substract chk and address length
-    for (MEMIMAGE_ADDR_T i=0; i<len; i++) {
-      
-      // get next value
-      sprintf(tmp,"0x00");
-      strncpy(tmp+2, line+idx, 2);      // get next 2 chars as string
-      sscanf(tmp, "%x", &value);        // interpret as hex data
-
-      // store data byte in memory image
-      assert(MemoryImage_addData(image, address+i, (uint8_t) value));
-
-      chkCalc += (uint8_t) value;       // increase checksum
-      idx+=2;                           // advance 2 chars in line
-    }
-
-    // read checksum
-    sprintf(tmp,"0x00");
-    strncpy(tmp+2, line+idx, 2);
-    sscanf(tmp, "%x", &value);
-    chkRead = (uint8_t) value;
-
-    // assert checksum (0xFF xor (sum over all except record type)
-    chkCalc ^= 0xFF;                 // invert checksum
-    if (chkCalc != chkRead) {
-      MemoryImage_free(image);
-      Error("Line %u in Motorola S-record: checksum error (0x%02" PRIX8 " vs. 0x%02" PRIX8 ")", linecount, (uint8_t) chkRead, (uint8_t) chkCalc);
-    }
-
-  } // while !EOF
+  // parse records, for large files in parallel
+  if (!parse_records(&file, 'S', numThreads, image, error)) {
+    FileBuffer_close(&file);
+    MemoryImage_free(image);
+    Error("%s", error);
+  }
 
   //=====================
   // end data import
@@ -153,7 +975,7 @@ void import_file_s19(const char *filename, MemoryImage_s *image, const uint8_t v
 
 
   // close file again
-  fclose(fp);
+  FileBuffer_close(&file);
 
   // print message
   if (verbose == SILENT) {
@@ -172,13 +994,13 @@ void import_file_s19(const char *filename, MemoryImage_s *image, const uint8_t v
   else if (verbose == CHATTY) {
     if (image->numEntries > 1024*1024)
       printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 1024)
       printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 0)
       printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (int) image->numEntries, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else
       printf("done, no data\n");
   }
@@ -189,18 +1011,20 @@ void import_file_s19(const char *filename, MemoryImage_s *image, const uint8_t v
 
 
 /**
-  \fn void import_file_ihx(const char *filename, MemoryImage_s *image, const uint8_t verbose)
+  \fn void import_file_ihx(const char *filename, MemoryImage_s *image, const int numThreads, const uint8_t verbose)
 
-  \param[in]  filename    full name of file to read 
+  \param[in]  filename    full name of file to read, or "-" for stdin
   \param      image       pointer to memory image. Must be initialized. Existing content is overwritten
+  \param[in]  numThreads  max. number of threads for parsing large files
   \param[in]  verbose     verbosity level (0=MUTE, 1=SILENT, 2=INFORM, 3=CHATTY)
 
   Read Intel hexfile into memory image. For description of
   Intel hex file format see http://en.wikipedia.org/wiki/Intel_HEX
 */
-void import_file_ihx(const char *filename, MemoryImage_s *image, const uint8_t verbose) {
+void import_file_ihx(const char *filename, MemoryImage_s *image, const int numThreads, const uint8_t verbose) {
 
-  FILE      *fp;
+  FileBuffer_s  file;                 // file content
+  char          error[IMPORT_ERROR_LEN];  // error message from parsing
 
   // strip path from filename for readability
   #if defined(WIN32)
@@ -223,7 +1047,7 @@ void import_file_ihx(const char *filename, MemoryImage_s *image, const uint8_t v
   fflush(stdout);
 
   // open file to read
-  if (!(fp = fopen(filename, "rb"))) {
+  if (!FileBuffer_open(&file, filename)) {
     MemoryImage_free(image);
     Error("Failed to open file %s with error [%s]", filename, strerror(errno));
   }
@@ -233,126 +1057,108 @@ void import_file_ihx(const char *filename, MemoryImage_s *image, const uint8_t v
   // start data import
   //=====================
 
-  char              line[STRLEN], tmp[STRLEN];
-  int               linecount = 0, idx, len;
-  uint8_t           type, chkRead, chkCalc;
-  MEMIMAGE_ADDR_T   address = 0; 
-  uint64_t          addrOffset, addrJumpStart;
-  int               value = 0;
+  // parse records, for large files in parallel
+  if (!parse_records(&file, ':', numThreads, image, error)) {
+    FileBuffer_close(&file);
+    MemoryImage_free(image);
+    Error("%s", error);
+  }
 
-  // avoid compiler warning (variable not yet used). See https://stackoverflow.com/questions/3599160/unused-parameter-warnings-in-c
-  (void) (addrJumpStart);
+  //=====================
+  // end data import
+  //=====================
 
-  // read data line by line
-  addrOffset = 0x0000000000000000;
-  while (fgets(line, STRLEN, fp)) {
 
-    // increase line counter
-    linecount++;
+  // close file again
+  FileBuffer_close(&file);
 
-    // check 1st char (must be ':')
-    if (line[0] != ':') {
-      MemoryImage_free(image);
-      Error("Line %u in Intel hex record: line does not start with ':'", linecount);
-    }
+  // print message
+  if (verbose == SILENT){
+    printf("done\n");
+  }
+  else if (verbose == INFORM) {
+    if (image->numEntries > 1024*1024)
+      printf("done (%1.1fMB)\n", (float) image->numEntries/1024.0/1024.0);
+    else if (image->numEntries > 1024)
+      printf("done (%1.1fkB)\n", (float) image->numEntries/1024.0);
+    else if (image->numEntries > 0)
+      printf("done (%dB)\n", (int) image->numEntries);
+    else
+      printf("done, no data\n");
+  }
+  else if (verbose == CHATTY) {
+    if (image->numEntries > 1024*1024)
+      printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0/1024.0, 
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
+    else if (image->numEntries > 1024)
+      printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0, 
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
+    else if (image->numEntries > 0)
+      printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (int) image->numEntries, 
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
+    else
+      printf("done, no data\n");
+  }
+  fflush(stdout);
 
-    // record length (address + data + checksum)
-    sprintf(tmp,"0x00");
-    strncpy(tmp+2, line+1, 2);
-    sscanf(tmp, "%x", &value);
-    len = value;
-    chkCalc = len;
-
-    // 16b address
-    sprintf(tmp,"0x0000");
-    strncpy(tmp+2, line+3, 4);
-    sscanf(tmp, "%x", &value);
-    chkCalc += (uint8_t) (value >> 8);
-    chkCalc += (uint8_t)  value;
-    address = (uint64_t) (value + addrOffset);    // add offset for >64kB addresses
-
-    // record type
-    sprintf(tmp,"0x00");
-    strncpy(tmp+2, line+7, 2);
-    sscanf(tmp, "%x", &value);
-    type = value;
-    chkCalc += type;
-
-    // record contains data
-    if (type==0) {
-
-      // get data
-      idx = 9;                            // start at index 9
-      for (int i=0; i<len; i++) {
-        
-        // get next value
-        sprintf(tmp,"0x00");
-        strncpy(tmp+2, line+idx, 2);      // get next 2 chars as string
-        sscanf(tmp, "%x", &value);        // interpret as hex data
-        
-        // store data byte in memory image
-        assert(MemoryImage_addData(image, address+i, (uint8_t) value));
-        
-        chkCalc += value;                 // increase checksum
-        idx+=2;                           // advance 2 chars in line
-      }
+} // import_file_ihx()
 
-    } // type==0
 
-    // EOF indicator
-    else if (type==1)
-      continue;
 
-    // extended segment addresses not yet supported
-    else if (type==2) {
-      MemoryImage_free(image);
-      Error("Line %u in Intel hex record: extended segment address type 2 not supported", linecount);
-    }
+/**
+  \fn void import_file_txt(const char *filename, MemoryImage_s *image, const uint8_t verbose)
 
-    // start segment address (only relevant for 80x86 processor, ignore here)
-    else if (type==3)
-      continue;
+  \param[in]  filename    full name of file to read 
+  \param      image       pointer to memory image. Must be initialized. Existing content is overwritten
+  \param[in]  verbose     verbosity level (0=MUTE, 1=SILENT, 2=INFORM, 3=CHATTY)
 
-    // extended address (=upper 16b of address for following data records)
-    else if (type==4) {
-      idx = 13;                       // start at index 13
-      sprintf(tmp,"0x0000");
-      strncpy(tmp+2, line+9, 4);      // get next 4 chars as string
-      sscanf(tmp, "%x", &value);      // interpret as hex data
-      chkCalc += (uint8_t) (value >> 8);
-      chkCalc += (uint8_t)  value;
-      addrOffset = ((uint64_t) value) << 16;
-    } // type==4
-
-    // start linear address records. Can be ignored, see http://www.keil.com/support/docs/1584/
-    else if (type==5)
-      continue;
+  Read plain table (address / value) file into image memory.
+  Address and value may be decimal (plain numbers) or hexadecimal (starting with '0x').
+  Empty lines and lines starting with '#' are ignored, as are further columns.
+  Malformed addresses or values are reported with line number.
+*/
+void import_file_txt(const char *filename, MemoryImage_s *image, const uint8_t verbose) {
 
-    // unsupported record type -> error
-    else {
-      MemoryImage_free(image);
-      Error("Line %u in Intel hex record: unsupported type %d", linecount, type);
-    }
+  FileBuffer_s  file;                 // file content
+  char          error[IMPORT_ERROR_LEN];  // error message from parsing
+
+  // strip path from filename for readability
+  #if defined(WIN32)
+    const char *shortname = strrchr(filename, '\\');
+  #else
+    const char *shortname = strrchr(filename, '/');
+  #endif
+  if (!shortname)
+    shortname = filename;
+  else
+    shortname++;
 
+  // print message
+  if (verbose == SILENT)
+    printf("  read '%s' ... ", shortname);    
+  else if (verbose == INFORM)
+    printf("  read table '%s' ... ", shortname);
+  else if (verbose == CHATTY)
+    printf("  read ASCII table file '%s' ... ", shortname);
+  fflush(stdout);
 
-    // checksum
-    sprintf(tmp,"0x00");
-    strncpy(tmp+2, line+idx, 2);
-    sscanf(tmp, "%x", &value);
-    chkRead = value;
+  // open file to read
+  if (!FileBuffer_open(&file, filename)) {
+    MemoryImage_free(image);
+    Error("Failed to open file %s with error [%s]", filename, strerror(errno));
+  }
 
-    // assert checksum (0xFF xor (sum over all except record type))
-    chkCalc = 255 - chkCalc + 1;                 // calculate 2-complement
-    if (chkCalc != chkRead) {
-      MemoryImage_free(image);
-      Error("Line %u in Intel hex record: checksum error (0x%02" PRIX8 " vs. 0x%02" PRIX8 ")", linecount, (uint8_t) chkRead, (uint8_t) chkCalc);
-    }
 
-    // debug
-    //printf("%ld\n", linecount);
-    //fflush(stdout);
+  //=====================
+  // start data import
+  //=====================
 
-  } // while !EOF
+  // parse table and store data in memory image
+  if (!parse_table((const char*) file.data, file.size, image, error)) {
+    FileBuffer_close(&file);
+    MemoryImage_free(image);
+    Error("%s", error);
+  }
 
   //=====================
   // end data import
@@ -360,7 +1166,7 @@ void import_file_ihx(const char *filename, MemoryImage_s *image, const uint8_t v
 
 
   // close file again
-  fclose(fp);
+  FileBuffer_close(&file);
 
   // print message
   if (verbose == SILENT){
@@ -379,36 +1185,39 @@ void import_file_ihx(const char *filename, MemoryImage_s *image, const uint8_t v
   else if (verbose == CHATTY) {
     if (image->numEntries > 1024*1024)
       printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 1024)
       printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 0)
       printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (int) image->numEntries, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else
       printf("done, no data\n");
   }
   fflush(stdout);
 
-} // import_file_ihx()
+} // import_file_txt()
 
 
 
 /**
-  \fn void import_file_txt(const char *filename, MemoryImage_s *image, const uint8_t verbose)
+  \fn void import_file_bin(const char *filename, const MEMIMAGE_ADDR_T addrStart, const uint64_t offset, const uint64_t length, MemoryImage_s *image, const uint8_t verbose)
 
   \param[in]  filename    full name of file to read 
+  \param[in]  addrStart   address offset for binary import
+  \param[in]  offset      first byte in file to import
+  \param[in]  length      number of bytes to import, or 0 for remainder of file
   \param      image       pointer to memory image. Must be initialized. Existing content is overwritten
   \param[in]  verbose     verbosity level (0=MUTE, 1=SILENT, 2=INFORM, 3=CHATTY)
 
-  Read plain table (address / value) file into image memory.
-  Address and value may be decimal (plain numbers) or hexadecimal (starting with '0x').
-  Lines starting with '#' are ignored. No syntax check is performed.
+  Read binary file or slice of it into memory image. Binary data contains no absolute addresses, just data.
+  Therefore a starting address must also be provided.
 */
-void import_file_txt(const char *filename, MemoryImage_s *image, const uint8_t verbose) {
+void import_file_bin(const char *filename, const MEMIMAGE_ADDR_T addrStart, const uint64_t offset, const uint64_t length, MemoryImage_s *image, const uint8_t verbose) {
 
-  FILE      *fp;
+  FileBuffer_s  file;                 // file content
+  char          error[IMPORT_ERROR_LEN];  // error message from parsing
 
   // strip path from filename for readability
   #if defined(WIN32)
@@ -425,13 +1234,13 @@ void import_file_txt(const char *filename, MemoryImage_s *image, const uint8_t v
   if (verbose == SILENT)
     printf("  read '%s' ... ", shortname);    
   else if (verbose == INFORM)
-    printf("  read table '%s' ... ", shortname);
+    printf("  read BIN file '%s' ... ", shortname);
   else if (verbose == CHATTY)
-    printf("  read ASCII table file '%s' ... ", shortname);
+    printf("  read binary file '%s' ... ", shortname);
   fflush(stdout);
 
   // open file to read
-  if (!(fp = fopen(filename, "rb"))) {
+  if (!FileBuffer_open(&file, filename)) {
     MemoryImage_free(image);
     Error("Failed to open file %s with error [%s]", filename, strerror(errno));
   }
@@ -441,68 +1250,123 @@ void import_file_txt(const char *filename, MemoryImage_s *image, const uint8_t v
   // start data import
   //=====================
 
-  char            line[STRLEN];
-  int             linecount  = 0;
-  char            sAddr[STRLEN], sValue[STRLEN];
-  uint64_t        address = 0; 
-  unsigned int    value = 0;
+  // store requested slice in memory image
+  if (!import_slice(&file, filename, addrStart, offset, length, image, error)) {
+    FileBuffer_close(&file);
+    MemoryImage_free(image);
+    Error("%s", error);
+  }
 
-  // read data line by line
-  while (fgets(line, STRLEN, fp)) {
+  //=====================
+  // end data import
+  //=====================
 
-    // increase line counter
-    linecount++;
 
-    // if line starts with '#' ignore as comment
-    if (line[0] == '#')
-      continue;
+  // close file again
+  FileBuffer_close(&file);
 
-    // get address and value as string
-    sscanf(line, "%s %s", sAddr, sValue);
+  // print message
+  if (verbose == SILENT){
+    printf("done\n");
+  }
+  else if (verbose == INFORM) {
+    if (image->numEntries > 1024*1024)
+      printf("done (%1.1fMB)\n", (float) image->numEntries/1024.0/1024.0);
+    else if (image->numEntries > 1024)
+      printf("done (%1.1fkB)\n", (float) image->numEntries/1024.0);
+    else if (image->numEntries > 0)
+      printf("done (%dB)\n", (int) image->numEntries);
+    else
+      printf("done, no data\n");
+  }
+  else if (verbose == CHATTY) {
+    if (image->numEntries > 1024*1024)
+      printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0/1024.0, 
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
+    else if (image->numEntries > 1024)
+      printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0, 
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
+    else if (image->numEntries > 0)
+      printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (int) image->numEntries, 
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
+    else
+      printf("done, no data\n");
+  }
+  fflush(stdout);
 
+} // import_file_bin()
 
-    //////////
-    // extract address
-    //////////
 
-    // if string is in hex format, read it
-    if (isHexString(sAddr))
-      sscanf(sAddr, "%" SCNx64, &address);
 
-    // if string is in decimal format, read it
-    else if (isDecString(sAddr))
-      sscanf(sAddr, "%" SCNu64, &address);
+/**
+  \fn format_t import_file_auto(const char *filename, const MEMIMAGE_ADDR_T addrStart, const uint64_t offset, const uint64_t length, MemoryImage_s *image, const int numThreads, const uint8_t verbose)
 
-    // invalid string format
-    else {
-      MemoryImage_free(image);
-      Error("Line %u in table: invalid address '%s'", linecount, sAddr);
-    }
+  \param[in]  filename    full name of file to read, or "-" for stdin
+  \param[in]  addrStart   binary only: address offset
+  \param[in]  offset      binary only: first byte in file to import
+  \param[in]  length      binary only: number of bytes to import, or 0 for remainder of file
+  \param      image       pointer to memory image. Must be initialized. Existing content is overwritten
+  \param[in]  numThreads  max. number of threads for parsing large files
+  \param[in]  verbose     verbosity level (0=MUTE, 1=SILENT, 2=INFORM, 3=CHATTY)
 
+  \return detected file format
 
-    //////////
-    // extract value
-    //////////
+  Read file with unknown format into memory image, e.g. for files without a supported extension.
+  The format is detected from the start of the file content via detect_format(), i.e. the file
+  is opened and read only once.
+*/
+format_t import_file_auto(const char *filename, const MEMIMAGE_ADDR_T addrStart, const uint64_t offset, const uint64_t length, MemoryImage_s *image, const int numThreads, const uint8_t verbose) {
 
-    // if string is in hex format, read it
-    if (isHexString(sValue))
-      sscanf(sValue, "%x", &value);
+  FileBuffer_s  file;                 // file content
+  char          error[IMPORT_ERROR_LEN];  // error message from parsing
 
-    // if string is in decimal format, read it
-    else if (isDecString(sValue))
-      sscanf(sValue, "%d", &value);
+  // strip path from filename for readability
+  #if defined(WIN32)
+    const char *shortname = strrchr(filename, '\\');
+  #else
+    const char *shortname = strrchr(filename, '/');
+  #endif
+  if (!shortname)
+    shortname = filename;
+  else
+    shortname++;
 
-    // invalid string format
-    else {
-      MemoryImage_free(image);
-      Error("Line %u in table: invalid value '%s'", linecount, sValue);
-    }
+  // open file to read. On failure print message w/o format, like concurrent import
+  if (!FileBuffer_open(&file, filename)) {
+    int err = errno;
+    if (verbose == SILENT)
+      printf("  read '%s' ... ", shortname);
+    else if ((verbose == INFORM) || (verbose == CHATTY))
+      printf("  read %s '%s' ... ", formatShort[FORMAT_UNKNOWN], shortname);
+    fflush(stdout);
+    errno = err;
+    MemoryImage_free(image);
+    Error("Failed to open file %s with error [%s]", filename, strerror(errno));
+  }
+
+  // detect format from file content
+  format_t format = detect_format(file.data, file.size);
+
+  // print message
+  if (verbose == SILENT)
+    printf("  read '%s' ... ", shortname);    
+  else if (verbose == INFORM)
+    printf("  read %s '%s' ... ", formatShort[format], shortname);
+  else if (verbose == CHATTY)
+    printf("  read %s '%s' ... ", formatLong[format], shortname);
+  fflush(stdout);
 
 
-    // store data byte in memory image
-    assert(MemoryImage_addData(image, (MEMIMAGE_ADDR_T) address, (uint8_t) value));
+  //=====================
+  // start data import
+  //=====================
 
-  } // while !EOF
+  // parse file content depending on format
+  if (!parse_file(&file, format, filename, addrStart, offset, length, numThreads, image, error)) {
+    FileBuffer_close(&file);
+    MemoryImage_free(image);
+    Error("%s", error);
+  }
 
   //=====================
   // end data import
@@ -510,7 +1374,7 @@ void import_file_txt(const char *filename, MemoryImage_s *image, const uint8_t v
 
 
   // close file again
-  fclose(fp);
+  FileBuffer_close(&file);
 
   // print message
   if (verbose == SILENT){
@@ -529,130 +1393,298 @@ void import_file_txt(const char *filename, MemoryImage_s *image, const uint8_t v
   else if (verbose == CHATTY) {
     if (image->numEntries > 1024*1024)
       printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 1024)
       printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 0)
       printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (int) image->numEntries, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else
       printf("done, no data\n");
   }
   fflush(stdout);
 
-} // import_file_txt()
+  return format;
+
+} // import_file_auto()
 
 
 
 /**
-  \fn void import_file_bin(const char *filename, const MEMIMAGE_ADDR_T addrStart, MemoryImage_s *image, const uint8_t verbose)
+  \fn void import_files(const ImportFile_s *files, const int numFiles, MemoryImage_s *image, const int numThreads, const uint8_t verbose)
 
-  \param[in]  filename    full name of file to read 
-  \param[in]  addrStart   address offset for binary import
+  \param[in]  files       list of files to read
+  \param[in]  numFiles    number of files to read
   \param      image       pointer to memory image. Must be initialized. Existing content is overwritten
+  \param[in]  numThreads  max. number of threads for file import
   \param[in]  verbose     verbosity level (0=MUTE, 1=SILENT, 2=INFORM, 3=CHATTY)
 
-  Read binary file into memory image. Binary data contains no absolute addresses, just data.
-  Therefore a starting address must also be provided.
+  Read several files into memory image. Files with format FORMAT_UNKNOWN are autodetected
+  from their content. Files are parsed concurrently into private images,
+  which are then added to image in list order, i.e. later files overwrite earlier ones like for
+  sequential import.
 */
-void import_file_bin(const char *filename, const MEMIMAGE_ADDR_T addrStart, MemoryImage_s *image, const uint8_t verbose) {
+void import_files(const ImportFile_s *files, const int numFiles, MemoryImage_s *image, const int numThreads, const uint8_t verbose) {
+
+  ImportTask_s      *tasks = NULL;      // import tasks
+  ImportWorker_s    *workers = NULL;    // worker threads
+  int               next = 0;           // index of next task to import
+
+  // number of workers and threads per file
+  int numWorkers = (numThreads < numFiles) ? numThreads : numFiles;
+  int numThreadsFile = (numThreads > numFiles) ? numThreads / numFiles : 1;
+
+  // allocate task buffers
+  if (numWorkers > 1) {
+    tasks   = (ImportTask_s*) calloc(numFiles, sizeof(ImportTask_s));
+    workers = (ImportWorker_s*) calloc(numWorkers, sizeof(ImportWorker_s));
+  }
+
+  // single file or allocation failed -> import sequentially into image
+  if ((tasks == NULL) || (workers == NULL)) {
+    for (int i = 0; i < numFiles; i++)
+      import_file(&(files[i]), image, numThreads, verbose);
+    free(tasks);
+    free(workers);
+    return;
+  }
+
+  // import files in parallel into private images
+  for (int i = 0; i < numFiles; i++) {
+    tasks[i].file       = &(files[i]);
+    tasks[i].numThreads = numThreadsFile;
+    tasks[i].format     = files[i].format;
+    MemoryImage_init(&(tasks[i].image));
+  }
+  for (int i = 0; i < numWorkers; i++) {
+    workers[i].tasks    = tasks;
+    workers[i].numTasks = numFiles;
+    workers[i].next     = &next;
+  }
+  runParallel(import_worker, workers, sizeof(ImportWorker_s), numWorkers);
+
+  // add images in list order, i.e. later files overwrite earlier ones
+  for (int i = 0; i < numFiles; i++) {
+
+    // strip path from filename for readability
+    const char *filename = files[i].filename;
+    #if defined(WIN32)
+      const char *shortname = strrchr(filename, '\\');
+    #else
+      const char *shortname = strrchr(filename, '/');
+    #endif
+    if (!shortname)
+      shortname = filename;
+    else
+      shortname++;
+
+    // print message
+    if (verbose == SILENT)
+      printf("  read '%s' ... ", shortname);
+    else if (verbose == INFORM)
+      printf("  read %s '%s' ... ", formatShort[tasks[i].format], shortname);
+    else if (verbose == CHATTY)
+      printf("  read %s '%s' ... ", formatLong[tasks[i].format], shortname);
+    fflush(stdout);
+
+    // report failed import in list order, i.e. after message of failed file
+    if (tasks[i].failed) {
+      char error[IMPORT_ERROR_LEN];
+      memcpy(error, tasks[i].error, sizeof(error));
+      for (int j = i; j < numFiles; j++)
+        MemoryImage_free(&(tasks[j].image));
+      free(tasks);
+      free(workers);
+      MemoryImage_free(image);
+      Error("%s", error);
+    }
+
+    // add file data to image segment by segment. Cost depends only on file size, not on image size
+    bool result = true;
+    for (size_t j = 0; (result) && (j < tasks[i].image.numSegments); j++) {
+      const MemorySegment_s *segment = &(tasks[i].image.segments[j]);
+      result = MemoryImage_addBlock(image, segment->address, segment->data, segment->numBytes);
+    }
+    MemoryImage_free(&(tasks[i].image));
+    if (!result) {
+      for (int j = i+1; j < numFiles; j++)
+        MemoryImage_free(&(tasks[j].image));
+      free(tasks);
+      free(workers);
+      MemoryImage_free(image);
+      Error("Failed to merge file %s", filename);
+    }
+
+    // print message
+    if (verbose == SILENT) {
+      printf("done\n");
+    }
+    else if (verbose == INFORM) {
+      if (image->numEntries > 1024*1024)
+        printf("done (%1.1fMB)\n", (float) image->numEntries/1024.0/1024.0);
+      else if (image->numEntries > 1024)
+        printf("done (%1.1fkB)\n", (float) image->numEntries/1024.0);
+      else if (image->numEntries > 0)
+        printf("done (%dB)\n", (int) image->numEntries);
+      else
+        printf("done, no data\n");
+    }
+    else if (verbose == CHATTY) {
+      if (image->numEntries > 1024*1024)
+        printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0/1024.0, 
+          (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
+      else if (image->numEntries > 1024)
+        printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0, 
+          (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
+      else if (image->numEntries > 0)
+        printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (int) image->numEntries, 
+          (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
+      else
+        printf("done, no data\n");
+    }
+    fflush(stdout);
+
+  } // loop over files
+
+  // release task buffers
+  free(tasks);
+  free(workers);
+
+} // import_files()
+
+
+
+/**
+  \fn bool import_buffer_s19_len(const uint8_t *buf, const size_t lenBuf, MemoryImage_s *image, char *error)
+
+  \param[in]  buf         RAM buffer to read. Is not modified and need not be NUL terminated
+  \param[in]  lenBuf      size of buffer [B]
+  \param      image       pointer to memory image. Must be initialized. Existing content is overwritten
+  \param[out] error       error message on failure, IMPORT_ERROR_LEN bytes. May be NULL
+
+  \return all records valid. On failure image contains the data of the preceding records
+
+  Import RAM buffer containing Motorola s19 hexfile into memory image. For description of
+  Motorola S19 file format see http://en.wikipedia.org/wiki/SREC_(file_format).
+  Prints no messages and doesn't exit on error, i.e. can be called concurrently on different images.
+*/
+bool import_buffer_s19_len(const uint8_t *buf, const size_t lenBuf, MemoryImage_s *image, char *error) {
+
+  const char      *line;
+  size_t          lenLine, pos = 0;
+  int             linecount = 0;
+  char            msg[IMPORT_ERROR_LEN];
+
+  // read buffer line by line
+  while ((line = next_line((const char*) buf, lenBuf, &pos, &lenLine)) != NULL) {
+
+    // increase line counter
+    linecount++;
+
+    // skip empty lines
+    if (lenLine == 0)
+      continue;
+
+    // decode record and store data in memory image
+    if (!parse_record_s19(line, lenLine, linecount, image, msg)) {
+      if (error != NULL)
+        memcpy(error, msg, IMPORT_ERROR_LEN);
+      return false;
+    }
+
+  } // while ! end of buffer
+
+  return true;
+
+} // import_buffer_s19_len()
+
+
+
+/**
+  \fn bool import_buffer_ihx_len(const uint8_t *buf, const size_t lenBuf, MemoryImage_s *image, char *error)
+
+  \param[in]  buf         RAM buffer to read. Is not modified and need not be NUL terminated
+  \param[in]  lenBuf      size of buffer [B]
+  \param      image       pointer to memory image. Must be initialized. Existing content is overwritten
+  \param[out] error       error message on failure, IMPORT_ERROR_LEN bytes. May be NULL
+
+  \return all records valid. On failure image contains the data of the preceding records
+
+  Read RAM buffer containing Intel hexfile into memory image. For description of
+  Intel hex file format see http://en.wikipedia.org/wiki/Intel_HEX.
+  Prints no messages and doesn't exit on error, i.e. can be called concurrently on different images.
+*/
+bool import_buffer_ihx_len(const uint8_t *buf, const size_t lenBuf, MemoryImage_s *image, char *error) {
+
+  const char      *line;
+  size_t          lenLine, pos = 0;
+  int             linecount = 0;
+  char            msg[IMPORT_ERROR_LEN];
+  uint64_t        addrOffset = 0x0000000000000000;
 
-  FILE      *fp;
+  // read buffer line by line
+  while ((line = next_line((const char*) buf, lenBuf, &pos, &lenLine)) != NULL) {
 
-  // strip path from filename for readability
-  #if defined(WIN32)
-    const char *shortname = strrchr(filename, '\\');
-  #else
-    const char *shortname = strrchr(filename, '/');
-  #endif
-  if (!shortname)
-    shortname = filename;
-  else
-    shortname++;
+    // increase line counter
+    linecount++;
 
-  // print message
-  if (verbose == SILENT)
-    printf("  read '%s' ... ", shortname);    
-  else if (verbose == INFORM)
-    printf("  read BIN file '%s' ... ", shortname);
-  else if (verbose == CHATTY)
-    printf("  read binary file '%s' ... ", shortname);
-  fflush(stdout);
+    // skip empty lines
+    if (lenLine == 0)
+      continue;
 
-  // open file to read
-  if (!(fp = fopen(filename, "rb"))) {
-    MemoryImage_free(image);
-    Error("Failed to open file %s with error [%s]", filename, strerror(errno));
-  }
+    // decode record and store data in memory image
+    if (!parse_record_ihx(line, lenLine, linecount, &addrOffset, image, msg)) {
+      if (error != NULL)
+        memcpy(error, msg, IMPORT_ERROR_LEN);
+      return false;
+    }
 
+  } // while ! end of buffer
 
-  //=====================
-  // start data import
-  //=====================
+  return true;
 
-  // read bytes and store to image
-  MEMIMAGE_ADDR_T  address = addrStart;
-  uint8_t  value;
-  while (!feof(fp)) {
-    
-    // read next byte
-    fread(&value, sizeof(uint8_t), 1, fp);
+} // import_buffer_ihx_len()
 
-    // store in memory image
-    if (!feof(fp))
-      assert(MemoryImage_addData(image, (MEMIMAGE_ADDR_T) address, (uint8_t) value));
 
-    // increment address
-    address++;
 
-  } // while !EOF
+/**
+  \fn bool import_buffer_txt_len(const uint8_t *buf, const size_t lenBuf, MemoryImage_s *image, char *error)
 
-  //=====================
-  // end data import
-  //=====================
+  \param[in]  buf         RAM buffer to read. Is not modified and need not be NUL terminated
+  \param[in]  lenBuf      size of buffer [B]
+  \param      image       pointer to memory image. Must be initialized. Existing content is overwritten
+  \param[out] error       error message on failure, IMPORT_ERROR_LEN bytes. May be NULL
 
+  \return all lines valid. On failure image is unchanged
 
-  // close file again
-  fclose(fp);
+  Read plain table (address / value) buffer into image memory.
+  Address and value may be decimal (plain numbers) or hexadecimal (starting with '0x').
+  Empty lines and lines starting with '#' are ignored, as are further columns.
+  Malformed addresses or values are reported with line number.
+  Prints no messages and doesn't exit on error, i.e. can be called concurrently on different images.
+*/
+bool import_buffer_txt_len(const uint8_t *buf, const size_t lenBuf, MemoryImage_s *image, char *error) {
 
-  // print message
-  if (verbose == SILENT){
-    printf("done\n");
-  }
-  else if (verbose == INFORM) {
-    if (image->numEntries > 1024*1024)
-      printf("done (%1.1fMB)\n", (float) image->numEntries/1024.0/1024.0);
-    else if (image->numEntries > 1024)
-      printf("done (%1.1fkB)\n", (float) image->numEntries/1024.0);
-    else if (image->numEntries > 0)
-      printf("done (%dB)\n", (int) image->numEntries);
-    else
-      printf("done, no data\n");
-  }
-  else if (verbose == CHATTY) {
-    if (image->numEntries > 1024*1024)
-      printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
-    else if (image->numEntries > 1024)
-      printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
-    else if (image->numEntries > 0)
-      printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (int) image->numEntries, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
-    else
-      printf("done, no data\n");
+  char  msg[IMPORT_ERROR_LEN];          // error message from parsing
+
+  // parse table and store data in memory image
+  if (!parse_table((const char*) buf, lenBuf, image, msg)) {
+    if (error != NULL)
+      memcpy(error, msg, IMPORT_ERROR_LEN);
+    return false;
   }
-  fflush(stdout);
 
-} // import_file_bin()
+  return true;
+
+} // import_buffer_txt_len()
 
 
 
 /**
   \fn void import_buffer_s19(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose)
 
-  \param[in]  buf         RAM buffer to read (NUL terminated)
+  \param[in]  buf         RAM buffer to read, NUL terminated. Is not modified
   \param      image       pointer to memory image. Must be initialized. Existing content is overwritten
   \param[in]  verbose     verbosity level (0=MUTE, 1=SILENT, 2=INFORM, 3=CHATTY)
 
@@ -661,6 +1693,8 @@ void import_file_bin(const char *filename, const MEMIMAGE_ADDR_T addrStart, Memo
 */
 void import_buffer_s19(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose) {
 
+  char  error[IMPORT_ERROR_LEN];        // error message from parsing
+
   // print message
   if (verbose == SILENT)
     printf("  import ... ");    
@@ -675,87 +1709,11 @@ void import_buffer_s19(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose
   // start data import
   //=====================
 
-  char              *line, tmp[STRLEN];
-  int               linecount = 0, idx, len;
-  uint8_t           type, chkRead, chkCalc;
-  MEMIMAGE_ADDR_T   address = 0; 
-  int               value = 0;
-
-  // read buffer line by line
-  line = strtok((char*) buf, "\n\r");
-  while (line != NULL) {
-
-    // increase line counter
-    linecount++;
-
-    // check 1st char (must be 'S')
-    if (line[0] != 'S') {
-      MemoryImage_free(image);
-      Error("Line %u in Motorola S-record: line does not start with 'S'", linecount);
-    }
-
-    // record type
-    type = line[1]-48;
-
-    // skip if line contains no data, i.e. line doesn't start with S1, S2 or S3
-    if ((type != 1) && (type != 2) && (type != 3)) {
-      line  = strtok(NULL, "\n\r");
-      continue;
-    }
-
-    // record length (address + data + checksum)
-    sprintf(tmp,"0x00");
-    strncpy(tmp+2, line+2, 2);
-    sscanf(tmp, "%x", &value);
-    len = value;
-    chkCalc = value;
-
-    // address (S1=16bit, S2=24bit, S3=32bit)
-    address = 0;
-    for (int i=0; i<type+1; i++) {
-      sprintf(tmp,"0x00");
-      tmp[2] = line[4+(i*2)];
-      tmp[3] = line[5+(i*2)];
-      sscanf(tmp, "%x", &value);
-      address *= (uint64_t) 256;
-      address += (uint64_t) value;
-      chkCalc += (uint8_t) value;
-    }
-
-    // read record data
-    idx = 6+(type*2);                   // start at position 8, 10, or 12, depending on record type
-    len = len-1-(1+type);               // substract chk and address length
-    for (MEMIMAGE_ADDR_T i=0; i<len; i++) {
-      
-      // get next value
-      sprintf(tmp,"0x00");
-      strncpy(tmp+2, line+idx, 2);      // get next 2 chars as string
-      sscanf(tmp, "%x", &value);        // interpret as hex data
-
-      // store data byte in memory image
-      assert(MemoryImage_addData(image, address+i, (uint8_t) value));
-
-      chkCalc += (uint8_t) value;       // increase checksum
-      idx+=2;                           // advance 2 chars in line
-    }
-
-    // read checksum
-    sprintf(tmp,"0x00");
-    strncpy(tmp+2, line+idx, 2);
-    sscanf(tmp, "%x", &value);
-    chkRead = (uint8_t) value;
-
-    // assert checksum (0xFF xor (sum over all except record type)
-    chkCalc ^= 0xFF;                 // invert checksum
-    if (chkCalc != chkRead) {
-      MemoryImage_free(image);
-      Error("Line %u in Motorola S-record: checksum error (0x%02" PRIX8 " vs. 0x%02" PRIX8 ")", linecount, (uint8_t) chkRead, (uint8_t) chkCalc);
-    }
-
-    // get next line
-    line = strtok(NULL, "\n\r");
-
-  } // while ! end of buffer
+  // parse records and store data in memory image
+  if (!import_buffer_s19_len(buf, strlen((const char*) buf), image, error)) {
+    MemoryImage_free(image);
+    Error("%s", error);
+  }
 
   //=====================
   // end data import
@@ -779,13 +1737,13 @@ void import_buffer_s19(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose
   else if (verbose == CHATTY) {
     if (image->numEntries > 1024*1024)
       printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 1024)
       printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 0)
       printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (int) image->numEntries, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else
       printf("done, no data\n");
   }
@@ -798,7 +1756,7 @@ void import_buffer_s19(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose
 /**
   \fn void import_buffer_ihx(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose)
 
-  \param[in]  buf         RAM buffer to read (NUL terminated)
+  \param[in]  buf         RAM buffer to read, NUL terminated. Is not modified
   \param      image       pointer to memory image. Must be initialized. Existing content is overwritten
   \param[in]  verbose     verbosity level (0=MUTE, 1=SILENT, 2=INFORM, 3=CHATTY)
 
@@ -807,6 +1765,8 @@ void import_buffer_s19(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose
 */
 void import_buffer_ihx(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose) {
 
+  char  error[IMPORT_ERROR_LEN];        // error message from parsing
+
   // print message
   if (verbose == SILENT)
     printf("  import ... ");    
@@ -821,136 +1781,11 @@ void import_buffer_ihx(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose
   // start data import
   //=====================
 
-  char              *line, tmp[STRLEN];
-  int               linecount = 0, idx, len;
-  uint8_t           type, chkRead, chkCalc;
-  MEMIMAGE_ADDR_T   address = 0; 
-  uint64_t          addrOffset, addrJumpStart;
-  int               value = 0;
-
-  // avoid compiler warning (variable not yet used). See https://stackoverflow.com/questions/3599160/unused-parameter-warnings-in-c
-  (void) (addrJumpStart);
-
-  // read data line by line
-  addrOffset = 0x0000000000000000;
-  line = strtok((char*) buf, "\n\r");
-  while (line != NULL) {
-
-    // increase line counter
-    linecount++;
-
-    // check 1st char (must be ':')
-    if (line[0] != ':') {
-      MemoryImage_free(image);
-      Error("Line %u in Intel hex record: line does not start with ':'", linecount);
-    }
-
-    // record length (address + data + checksum)
-    sprintf(tmp,"0x00");
-    strncpy(tmp+2, line+1, 2);
-    sscanf(tmp, "%x", &value);
-    len = value;
-    chkCalc = len;
-
-    // 16b address
-    sprintf(tmp,"0x0000");
-    strncpy(tmp+2, line+3, 4);
-    sscanf(tmp, "%x", &value);
-    chkCalc += (uint8_t) (value >> 8);
-    chkCalc += (uint8_t)  value;
-    address = (uint64_t) (value + addrOffset);    // add offset for >64kB addresses
-
-    // record type
-    sprintf(tmp,"0x00");
-    strncpy(tmp+2, line+7, 2);
-    sscanf(tmp, "%x", &value);
-    type = value;
-    chkCalc += type;
-
-    // record contains data
-    if (type==0) {
-
-      // get data
-      idx = 9;                            // start at index 9
-      for (int i=0; i<len; i++) {
-        
-        // get next value
-        sprintf(tmp,"0x00");
-        strncpy(tmp+2, line+idx, 2);      // get next 2 chars as string
-        sscanf(tmp, "%x", &value);        // interpret as hex data
-        
-        // store data byte in memory image
-        assert(MemoryImage_addData(image, address+i, (uint8_t) value));
-        
-        chkCalc += value;                 // increase checksum
-        idx+=2;                           // advance 2 chars in line
-      }
-
-    } // type==0
-
-    // EOF indicator
-    else if (type==1) {
-      line  = strtok(NULL, "\n\r");
-      continue;
-    }
-  
-    // extended segment addresses not yet supported
-    else if (type==2) {
-      MemoryImage_free(image);
-      Error("Line %u in Intel hex record: extended segment address type 2 not supported", linecount);
-    }
-
-    // start segment address (only relevant for 80x86 processor, ignore here)
-    else if (type==3) {
-      line  = strtok(NULL, "\n\r");
-      continue;
-    }
-
-    // extended address (=upper 16b of address for following data records)
-    else if (type==4) {
-      idx = 13;                       // start at index 13
-      sprintf(tmp,"0x0000");
-      strncpy(tmp+2, line+9, 4);      // get next 4 chars as string
-      sscanf(tmp, "%x", &value);      // interpret as hex data
-      chkCalc += (uint8_t) (value >> 8);
-      chkCalc += (uint8_t)  value;
-      addrOffset = ((uint64_t) value) << 16;
-    } // type==4
-
-    // start linear address records. Can be ignored, see http://www.keil.com/support/docs/1584/
-    else if (type==5) {
-      line  = strtok(NULL, "\n\r");
-      continue;
-    }
-
-    // unsupported record type -> error
-    else {
-      MemoryImage_free(image);
-      Error("Line %u in Intel hex record: unsupported type %d", linecount, type);
-    }
-
-
-    // checksum
-    sprintf(tmp,"0x00");
-    strncpy(tmp+2, line+idx, 2);
-    sscanf(tmp, "%x", &value);
-    chkRead = value;
-
-    // assert checksum (0xFF xor (sum over all except record type))
-    chkCalc = 255 - chkCalc + 1;                 // calculate 2-complement
-    if (chkCalc != chkRead) {
-      MemoryImage_free(image);
-      Error("Line %u in Intel hex record: checksum error (0x%02" PRIX8 " vs. 0x%02" PRIX8 ")", linecount, (uint8_t) chkRead, (uint8_t) chkCalc);
-    }
-
-    // debug
-    //printf("%ld\n", linecount);
-    //fflush(stdout);
-
-    // get next line
-    line = strtok(NULL, "\n\r");
-
-  } // while ! end of buffer
+  // parse records and store data in memory image
+  if (!import_buffer_ihx_len(buf, strlen((const char*) buf), image, error)) {
+    MemoryImage_free(image);
+    Error("%s", error);
+  }
 
   //=====================
   // end data import
@@ -974,13 +1809,13 @@ void import_buffer_ihx(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose
   else if (verbose == CHATTY) {
     if (image->numEntries > 1024*1024)
       printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 1024)
       printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 0)
       printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (int) image->numEntries, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else
       printf("done, no data\n");
   }
@@ -993,16 +1828,18 @@ void import_buffer_ihx(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose
 /**
   \fn void import_buffer_txt(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose)
 
-  \param[in]  buf         RAM buffer to read (NUL terminated)
+  \param[in]  buf         RAM buffer to read, NUL terminated. Is not modified
   \param      image       pointer to memory image. Must be initialized. Existing content is overwritten
   \param[in]  verbose     verbosity level (0=MUTE, 1=SILENT, 2=INFORM, 3=CHATTY)
 
   Read plain table (address / value) file into image memory.
   Address and value may be decimal (plain numbers) or hexadecimal (starting with '0x').
-  Lines starting with '#' are ignored. No syntax check is performed.
+  Empty lines and lines starting with '#' are ignored, as are further columns.
 */
 void import_buffer_txt(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose) {
 
+  char  error[IMPORT_ERROR_LEN];        // error message from parsing
+
   // print message
   if (verbose == SILENT)
     printf("  import ... ");    
@@ -1017,73 +1854,11 @@ void import_buffer_txt(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose
   // start data import
   //=====================
 
-  char            *line;
-  int             linecount  = 0;
-  char            sAddr[STRLEN], sValue[STRLEN];
-  uint64_t        address = 0; 
-  unsigned int    value = 0;
-
-  // read data line by line
-  line = strtok((char*) buf, "\n\r");
-  while (line != NULL) {
-
-    // increase line counter
-    linecount++;
-
-    // if line starts with '#' ignore as comment
-    if (line[0] == '#') {
-      line  = strtok(NULL, "\n\r");
-      continue;
-    }
-
-    // get address and value as string
-    sscanf(line, "%s %s", sAddr, sValue);
-
-
-    //////////
-    // extract address
-    //////////
-
-    // if string is in hex format, read it
-    if (isHexString(sAddr))
-      sscanf(sAddr, "%" SCNx64, &address);
-
-    // if string is in decimal format, read it
-    else if (isDecString(sAddr))
-      sscanf(sAddr, "%" SCNu64, &address);
-
-    // invalid string format
-    else {
-      MemoryImage_free(image);
-      Error("Line %u in table: invalid address '%s'", linecount, sAddr);
-    }
-
-
-    //////////
-    // extract value
-    //////////
-
-    // if string is in hex format, read it
-    if (isHexString(sValue))
-      sscanf(sValue, "%x", &value);
-
-    // if string is in decimal format, read it
-    else if (isDecString(sValue))
-      sscanf(sValue, "%d", &value);
-
-    // invalid string format
-    else {
-      MemoryImage_free(image);
-      Error("Line %u in table: invalid value '%s'", linecount, sValue);
-    }
-
-    // store data byte in memory image
-    assert(MemoryImage_addData(image, (MEMIMAGE_ADDR_T) address, (uint8_t) value));
-
-    // get next line
-    line  = strtok(NULL, "\n\r");
-
-  } // while ! end of buffer
+  // parse table and store data in memory image
+  if (!import_buffer_txt_len(buf, strlen((const char*) buf), image, error)) {
+    MemoryImage_free(image);
+    Error("%s", error);
+  }
 
   //=====================
   // end data import
@@ -1107,13 +1882,13 @@ void import_buffer_txt(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose
   else if (verbose == CHATTY) {
     if (image->numEntries > 1024*1024)
       printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 1024)
       printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 0)
       printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (int) image->numEntries, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else
       printf("done, no data\n");
   }
@@ -1126,8 +1901,8 @@ void import_buffer_txt(uint8_t *buf, MemoryImage_s *image, const uint8_t verbose
 /**
   \fn void import_buffer_bin(const uint8_t *buf, const uint64_t lenBuf, const MEMIMAGE_ADDR_T addrStart, MemoryImage_s *image, const uint8_t verbose)
 
-  \param[in]  buf         RAM buffer to read (NUL terminated)
-  \param[in]  num         length of RAM buffer
+  \param[in]  buf         RAM buffer to read
+  \param[in]  lenBuf      size of buffer [B]
   \param[in]  addrStart   address offset for binary import
   \param      image       pointer to memory image. Must be initialized. Existing content is overwritten
   \param[in]  verbose     verbosity level (0=MUTE, 1=SILENT, 2=INFORM, 3=CHATTY)
@@ -1151,21 +1926,11 @@ void import_buffer_bin(const uint8_t *buf, const uint64_t lenBuf, const MEMIMAGE
   // start data import
   //=====================
 
-  // read bytes and store to image
-  MEMIMAGE_ADDR_T  address = addrStart;
-  uint8_t  value;
-  for (uint64_t i=0; i<lenBuf; i++) {
-    
-    // read next byte
-    value = buf[i];
-
-    // store in memory image
-    assert(MemoryImage_addData(image, (MEMIMAGE_ADDR_T) address, (uint8_t) value));
-
-    // increment address
-    address++;
-
-  } // while !EOF
+  // store buffer as one block in image
+  if (!MemoryImage_addBlock(image, addrStart, buf, (size_t) lenBuf)) {
+    MemoryImage_free(image);
+    Error("Failed to store binary buffer (%" PRIu64 "B)", (uint64_t) lenBuf);
+  }
 
   //=====================
   // end data import
@@ -1189,13 +1954,13 @@ void import_buffer_bin(const uint8_t *buf, const uint64_t lenBuf, const MEMIMAGE
   else if (verbose == CHATTY) {
     if (image->numEntries > 1024*1024)
       printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 1024)
       printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 0)
       printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (int) image->numEntries, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else
       printf("done, no data\n");
   }
@@ -1217,13 +1982,17 @@ void import_buffer_bin(const uint8_t *buf, const uint64_t lenBuf, const MEMIMAGE
 */
 void export_file_s19(char *filename, MemoryImage_s *image, const uint8_t verbose) {
 
-  FILE              *fp;                  // file pointer
+  FileWriter_s      file;                 // output file
   char              *shortname;           // filename w/o path
   const int         maxLine = 32;         // max. length of data line
   MEMIMAGE_ADDR_T   addrBlock, addrLine, addrStart, addrEnd;
-  size_t            idxStart, idxEnd;
+  size_t            idxBlock;             // index of memory block
+  const uint8_t     *data;                // data of memory block
   uint8_t           value;                // image data value
   uint32_t          chk;                  // checksum
+  int               lenAddr;              // address width [B]
+  char              type;                 // S-record type
+  OutputBuffer_s    out;                  // buffer for file output
 
   // strip path from filename for readability
   #if defined(WIN32)
@@ -1246,52 +2015,66 @@ void export_file_s19(char *filename, MemoryImage_s *image, const uint8_t verbose
   fflush(stdout);
 
   // open output file
-  fp = fopen(filename,"wb");
-  if (!fp) {
+  if (!FileWriter_open(&file, filename)) {
     MemoryImage_free(image);
     Error("Failed to create file %s with error [%s]", filename, strerror(errno));
   }
 
   // start with dummy header line to avoid 'srecord' warning
-  fprintf(fp, "S00E000068656C6C6F20776F726C6495\n");
+  outbuf_init(&out, &file);
+  outbuf_puts(&out, "S00E000068656C6C6F20776F726C6495\n");
 
   // loop over consecutive memory blocks in image
   addrBlock = 0x00;
-  while (MemoryImage_getMemoryBlock(image, addrBlock, &idxStart, &idxEnd)) {
+  addrEnd   = 0x00;
+  while (MemoryImage_getMemoryBlock(image, addrBlock, &idxBlock)) {
 
-    addrStart = image->memoryEntries[idxStart].address;
-    addrEnd   = image->memoryEntries[idxEnd].address;
+    addrStart = image->segments[idxBlock].address;
+    addrEnd   = addrStart + image->segments[idxBlock].numBytes - 1;
+    data      = image->segments[idxBlock].data;
 
     // loop over memory block and store in lines of max. 32B
     addrLine = addrStart;
     while (addrLine <= addrEnd) {
         
       // get length of next line to store (max. 32B)
-      int lenLine = 1;
-      while ((lenLine < maxLine) && ((addrLine+lenLine) <= addrEnd))
-        lenLine++;
-      //printf("0x%04" PRIX64 "   0x%04" PRIX64 "   %d\n", (uint64_t) addrLine, (uint64_t) (addrLine+lenLine-1), lenLine);
+      int lenLine = maxLine;
+      if (addrEnd - addrLine + 1 < (uint64_t) maxLine)
+        lenLine = (int) (addrEnd - addrLine + 1);
 
-      // save next line, accound for address width. See http://en.wikipedia.org/wiki/SREC_(file_format)
+      // get record type, accound for address width. See http://en.wikipedia.org/wiki/SREC_(file_format)
       if (addrLine+lenLine <= (uint64_t) 0xFFFF) {
-        fprintf(fp, "S1%02X%04X", lenLine+3, (int) addrLine);         // 16-bit address: 2B addr + data + 1B chk
-        chk = (uint8_t) (lenLine+3) + (uint8_t) addrLine + (uint8_t) (addrLine >> 8);
+        type = '1';         // 16-bit address: 2B addr + data + 1B chk
+        lenAddr = 2;
       }
       else if (addrLine+lenLine <= (uint64_t) 0xFFFFFF) {
-        fprintf(fp, "S2%02X%06X", lenLine+4, (int) addrLine);         // 24-bit address: 3B addr + data + 1B chk
-        chk = (uint8_t) (lenLine+4) + (uint8_t) addrLine + (uint8_t) (addrLine >> 8) + (uint8_t) (addrLine >> 16);
+        type = '2';         // 24-bit address: 3B addr + data + 1B chk
+        lenAddr = 3;
       }
       else {
-        fprintf(fp, "S3%02X%08X", lenLine+5, (int) addrLine);         // 32-bit address: 4B addr + data + 1B chk
-        chk = (uint8_t) (lenLine+5) + (uint8_t) addrLine + (uint8_t) (addrLine >> 8) + (uint8_t) (addrLine >> 16) + (uint8_t) (addrLine >> 24);
+        type = '3';         // 32-bit address: 4B addr + data + 1B chk
+        lenAddr = 4;
+      }
+
+      // encode record into output buffer
+      outbuf_reserve(&out, 2 + 2*(1+lenAddr+lenLine+1) + 1);
+      outbuf_putc(&out, 'S');
+      outbuf_putc(&out, type);
+      outbuf_puthex(&out, (uint8_t) (lenLine+lenAddr+1));
+      chk = (uint8_t) (lenLine+lenAddr+1);
+      for (int j=lenAddr-1; j>=0; j--) {
+        value = (uint8_t) (addrLine >> (8*j));
+        chk += value;
+        outbuf_puthex(&out, value);
       }
       for (int j=0; j<lenLine; j++) {
-        MemoryImage_getData(image, addrLine+j, &value);
+        value = data[addrLine-addrStart+j];
         chk += value;
-        fprintf(fp, "%02X", value);
+        outbuf_puthex(&out, value);
       }
       chk = ((chk & 0xFF) ^ 0xFF);
-      fprintf(fp, "%02X\n", (uint8_t) chk);
+      outbuf_puthex(&out, (uint8_t) chk);
+      outbuf_putc(&out, '\n');
 
       // go to next line
       addrLine += lenLine;
@@ -1305,15 +2088,18 @@ void export_file_s19(char *filename, MemoryImage_s *image, const uint8_t verbose
 
   // attach appropriate termination record, according to type of data records used
   if (addrEnd <= (uint64_t) 0xFFFF)
-    fprintf(fp, "S903FFFFFE\n");        // 16-bit addresses
+    outbuf_puts(&out, "S903FFFFFE\n");        // 16-bit addresses
   else if (addrEnd <= (uint64_t) 0xFFFFFF)
-    fprintf(fp, "S804FFFFFFFE\n");      // 24-bit addresses
+    outbuf_puts(&out, "S804FFFFFFFE\n");      // 24-bit addresses
   else
-    fprintf(fp, "S705FFFFFFFFFE\n");    // 32-bit addresses
+    outbuf_puts(&out, "S705FFFFFFFFFE\n");    // 32-bit addresses
 
-  // close output file
-  fflush(fp);
-  fclose(fp);
+  // write remaining buffer and close output file
+  outbuf_flush(&out);
+  if ((!FileWriter_close(&file)) || (out.error)) {
+    MemoryImage_free(image);
+    Error("Failed to write file %s with error [%s]", filename, strerror(errno));
+  }
 
   // print message
   if (verbose == SILENT){
@@ -1332,13 +2118,13 @@ void export_file_s19(char *filename, MemoryImage_s *image, const uint8_t verbose
   else if (verbose == CHATTY) {
     if (image->numEntries > 1024*1024)
       printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 1024)
       printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 0)
       printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (int) image->numEntries, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else
       printf("done, no data\n");
   }
@@ -1361,15 +2147,17 @@ void export_file_s19(char *filename, MemoryImage_s *image, const uint8_t verbose
 
 void export_file_ihx(char *filename, MemoryImage_s *image, const uint8_t verbose) {
 
-  FILE              *fp;               // file pointer
+  FileWriter_s      file;              // output file
   char              *shortname;        // filename w/o path
   const int         maxLine = 32;      // max. length of data line
   MEMIMAGE_ADDR_T   addrBlock, addrLine, addrStart, addrEnd;
-  size_t            idxStart, idxEnd;
+  size_t            idxBlock;          // index of memory block
+  const uint8_t     *data;             // data of memory block
   uint8_t           value;             // image data value
   uint32_t          chk;               // checksum
   bool              useEla = 0;        // whether ELA records needed
-  int64_t           addrEla;           // ELA record address
+  uint64_t          addrEla;           // ELA record address
+  OutputBuffer_s    out;               // buffer for file output
 
   // strip path from filename for readability
   #if defined(WIN32)
@@ -1392,52 +2180,67 @@ void export_file_ihx(char *filename, MemoryImage_s *image, const uint8_t verbose
   fflush(stdout);
 
   // open output file
-  fp=fopen(filename,"wb");
-  if (!fp) {
+  if (!FileWriter_open(&file, filename)) {
     MemoryImage_free(image);
     Error("Failed to create file %s with error [%s]", filename, strerror(errno));
   }
 
   // use ELA records if address range is greater than 16 bits
-  if ((MemoryImage_isEmpty(image) == false) && (image->memoryEntries[image->numEntries-1].address > 0xFFFF)) {
+  if ((MemoryImage_isEmpty(image) == false) && (MemoryImage_getLastAddress(image) > 0xFFFF)) {
     useEla  = true;
-    addrEla = -1;
+    addrEla = UINT64_MAX;              // no ELA record yet, differs from any addrLine >> 16
   }
 
   // loop over consecutive memory blocks in image
+  outbuf_init(&out, &file);
   addrBlock = 0x00;
-  while (MemoryImage_getMemoryBlock(image, addrBlock, &idxStart, &idxEnd)) {
+  while (MemoryImage_getMemoryBlock(image, addrBlock, &idxBlock)) {
 
-    addrStart = image->memoryEntries[idxStart].address;
-    addrEnd   = image->memoryEntries[idxEnd].address;
+    addrStart = image->segments[idxBlock].address;
+    addrEnd   = addrStart + image->segments[idxBlock].numBytes - 1;
+    data      = image->segments[idxBlock].data;
 
     // loop over memory block and store in lines of max. 32B
     addrLine = addrStart;
     while (addrLine <= addrEnd) {
         
       // get length of next line to store (max. 32B)
-      int lenLine = 1;
-      while ((lenLine < maxLine) && ((addrLine+lenLine) <= addrEnd))
-        lenLine++;
-      //printf("0x%04" PRIX64 "   0x%04" PRIX64 "   %d\n", (uint64_t) addrLine, (uint64_t) (addrLine+lenLine-1), lenLine);
-        
+      int lenLine = maxLine;
+      if (addrEnd - addrLine + 1 < (uint64_t) maxLine)
+        lenLine = (int) (addrEnd - addrLine + 1);
+
       // write ELA record if upper 16-bits of line is different than last ELA addr
       if ((useEla == true) && (addrEla != (addrLine >> 16))) {
         addrEla = addrLine >> 16;
         chk = ~(0x02 + 0x04 + (uint8_t) addrEla + (uint8_t) (addrEla >> 8)) + 1;
-        fprintf(fp, ":02000004%04X%02X\n", (uint16_t) addrEla, (uint8_t) chk);
+        outbuf_reserve(&out, 16);
+        outbuf_putc(&out, ':');
+        outbuf_puthex(&out, 0x02);
+        outbuf_puthex(&out, 0x00);
+        outbuf_puthex(&out, 0x00);
+        outbuf_puthex(&out, 0x04);
+        outbuf_puthex(&out, (uint8_t) (addrEla >> 8));
+        outbuf_puthex(&out, (uint8_t) addrEla);
+        outbuf_puthex(&out, (uint8_t) chk);
+        outbuf_putc(&out, '\n');
       }
 
-      // save next line
-      fprintf(fp, ":%02X%04X00", lenLine, (uint16_t) addrLine);
+      // encode data record into output buffer
+      outbuf_reserve(&out, 1 + 2*(4+lenLine+1) + 1);
+      outbuf_putc(&out, ':');
+      outbuf_puthex(&out, (uint8_t) lenLine);
+      outbuf_puthex(&out, (uint8_t) (addrLine >> 8));
+      outbuf_puthex(&out, (uint8_t) addrLine);
+      outbuf_puthex(&out, 0x00);
       chk = lenLine + (uint8_t) addrLine + (uint8_t) (addrLine >> 8);
-      for (uint8_t j = 0; j < lenLine; j++) {
-        MemoryImage_getData(image, addrLine+j, &value);
+      for (int j = 0; j < lenLine; j++) {
+        value = data[addrLine-addrStart+j];
         chk += value;
-        fprintf(fp, "%02X", value);
+        outbuf_puthex(&out, value);
       }
       chk = ~chk + 1;
-      fprintf(fp, "%02X\n", (uint8_t) chk);
+      outbuf_puthex(&out, (uint8_t) chk);
+      outbuf_putc(&out, '\n');
 
       // go to next line
       addrLine += lenLine;
@@ -1450,11 +2253,14 @@ void export_file_ihx(char *filename, MemoryImage_s *image, const uint8_t verbose
   } // loop over memory blocks in image
 
   // output end-of-file record
-  fprintf(fp, ":00000001FF\n");
+  outbuf_puts(&out, ":00000001FF\n");
 
-  // close output file
-  fflush(fp);
-  fclose(fp);
+  // write remaining buffer and close output file
+  outbuf_flush(&out);
+  if ((!FileWriter_close(&file)) || (out.error)) {
+    MemoryImage_free(image);
+    Error("Failed to write file %s with error [%s]", filename, strerror(errno));
+  }
 
   // print message
   if (verbose == SILENT){
@@ -1473,13 +2279,13 @@ void export_file_ihx(char *filename, MemoryImage_s *image, const uint8_t verbose
   else if (verbose == CHATTY) {
     if (image->numEntries > 1024*1024)
       printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 1024)
       printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 0)
       printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (int) image->numEntries, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else
       printf("done, no data\n");
   }
@@ -1500,14 +2306,16 @@ void export_file_ihx(char *filename, MemoryImage_s *image, const uint8_t verbose
 */
 void export_file_txt(char *filename, MemoryImage_s *image, const uint8_t verbose) {
 
-  FILE      *fp;               // file pointer
-  char      *shortname;        // filename w/o path
-  bool      flagFile = true;   // output to file or console?
+  FILE          *fp = stdout;       // console output
+  FileWriter_s  file;               // file output
+  OutputBuffer_s out;               // buffer for file output
+  char          line[64];           // table line
+  char          *shortname;         // filename w/o path
+  bool          flagFile = true;    // output to file or console?
 
   // output to stdout
   if (!strcmp(filename, "console")) {
     flagFile = false;
-    fp = stdout;
     if (verbose > MUTE)
       printf("  print memory\n");
     fflush(stdout);
@@ -1538,34 +2346,45 @@ void export_file_txt(char *filename, MemoryImage_s *image, const uint8_t verbose
     fflush(stdout);
 
     // open output file
-    fp=fopen(filename,"wb");
-    if (!fp) {
+    if (!FileWriter_open(&file, filename)) {
       MemoryImage_free(image);
       Error("Failed to create file %s with error [%s]", filename, strerror(errno));
     }
+    outbuf_init(&out, &file);
 
   } // output to file
 
   // output header
   if (flagFile)
-    fprintf(fp, "# address\tvalue\n");
+    outbuf_puts(&out, "# address\tvalue\n");
   else
     fprintf(fp, "    address\tvalue\n");
 
   // loop over image and output address, data in hex format
-  for (size_t i = 0; i < image->numEntries; i++) {
-    if (flagFile)
-      fprintf(fp, "0x%" PRIX64 "\t0x%02" PRIX8 "\n", (uint64_t) image->memoryEntries[i].address, (int) image->memoryEntries[i].data & 0xFF);
-    else
-      fprintf(fp, "    0x%" PRIX64 "\t0x%02" PRIX8 "\n", (uint64_t) image->memoryEntries[i].address, (int) image->memoryEntries[i].data & 0xFF);      
+  for (size_t i = 0; i < image->numSegments; i++) {
+    MemorySegment_s *segment = &(image->segments[i]);
+    for (size_t j = 0; j < segment->numBytes; j++) {
+      if (flagFile) {
+        snprintf(line, sizeof(line), "0x%" PRIX64 "\t0x%02" PRIX8 "\n", (uint64_t) (segment->address + j), (int) segment->data[j] & 0xFF);
+        outbuf_puts(&out, line);
+      }
+      else
+        fprintf(fp, "    0x%" PRIX64 "\t0x%02" PRIX8 "\n", (uint64_t) (segment->address + j), (int) segment->data[j] & 0xFF);      
+    }
   }
 
-  // close output file
-  fflush(fp);
-  if (flagFile)
-    fclose(fp);
-  else
+  // write remaining buffer and close output file
+  if (flagFile) {
+    outbuf_flush(&out);
+    if ((!FileWriter_close(&file)) || (out.error)) {
+      MemoryImage_free(image);
+      Error("Failed to write file %s with error [%s]", filename, strerror(errno));
+    }
+  }
+  else {
+    fflush(fp);
     fprintf(fp,"  ");
+  }
 
   // print message
   if (verbose == SILENT){
@@ -1584,13 +2403,13 @@ void export_file_txt(char *filename, MemoryImage_s *image, const uint8_t verbose
   else if (verbose == CHATTY) {
     if (image->numEntries > 1024*1024)
       printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 1024)
       printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) image->numEntries/1024.0, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else if (image->numEntries > 0)
       printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (int) image->numEntries, 
-        (uint64_t) image->memoryEntries[0].address, (uint64_t) image->memoryEntries[image->numEntries-1].address);
+        (uint64_t) MemoryImage_getFirstAddress(image), (uint64_t) MemoryImage_getLastAddress(image));
     else
       printf("done, no data\n");
   }
@@ -1601,21 +2420,25 @@ void export_file_txt(char *filename, MemoryImage_s *image, const uint8_t verbose
 
 
 /**
-   \fn void export_file_bin(char *filename, MemoryImage_s *image, const uint8_t verbose)
+   \fn void export_file_bin(char *filename, MemoryImage_s *image, const uint8_t fill, const uint8_t verbose)
 
    \param[in]  filename    name of output file
    \param[in]  image       pointer to memory image
+   \param[in]  fill        value for undefined data between memory segments
    \param[in]  verbose     verbosity level (0=MUTE, 1=SILENT, 2=INFORM, 3=CHATTY)
 
    Export memory image to binary file. Note that start address is not stored, and that
-   binary format does not allow for "holes" in the file, i.e. undefined data is stored as 0x00.
+   binary format does not allow for "holes" in the file, i.e. undefined data is stored as fill value.
+   Each memory segment is written in a single block. For fill value 0x00, gaps in uncompressed files
+   are skipped as holes, i.e. the file is sparse and only the data occupies disk space.
 */
-void export_file_bin(char *filename, MemoryImage_s *image, const uint8_t verbose) {
+void export_file_bin(char *filename, MemoryImage_s *image, const uint8_t fill, const uint8_t verbose) {
 
-  FILE      *fp;                  // file pointer
+  FileWriter_s    file;           // output file
   uint64_t  addrStart, addrStop;  // address range to export
-  uint64_t  countByte;            // number of actually exported bytes
-  uint8_t   value;
+  uint64_t  countByte;            // number of exported bytes, i.e. apparent file size
+  char      sparse[64] = "";      // actually written size for sparse file
+  bool      result = true;
 
   // strip path from filename for readability
   #if defined(WIN32)
@@ -1638,34 +2461,52 @@ void export_file_bin(char *filename, MemoryImage_s *image, const uint8_t verbose
   fflush(stdout);
 
   // open output file
-  fp=fopen(filename,"wb");
-  if (!fp) {
+  if (!FileWriter_open(&file, filename)) {
     MemoryImage_free(image);
     Error("Failed to create file %s with error [%s]", filename, strerror(errno));
   }
 
   // get address range including "holes"
   if (image->numEntries > 0) {
-    addrStart = image->memoryEntries[0].address;
-    addrStop  = image->memoryEntries[image->numEntries-1].address;
+    addrStart = MemoryImage_getFirstAddress(image);
+    addrStop  = MemoryImage_getLastAddress(image);
+    countByte = addrStop - addrStart + 1;
   }
   else {
-    addrStart = 0x01;   // make start>stop to skip below for loop
+    addrStart = 0x00;
     addrStop  = 0x00;
+    countByte = 0;
   }
 
-  // store every value in address range. Undefined values are set to 0x00
-  countByte = 0;
-  for (uint64_t address=addrStart; address<=addrStop; address++) {
-    if (!MemoryImage_getData(image, address, &value))
-      value = 0x00;
-    fwrite(&value,sizeof(value), 1, fp); // write byte per byte (image is 16-bit)
-    countByte++;
+  // write memory segments in single blocks. Gaps are filled, or skipped as holes for 0x00
+  uint64_t address = addrStart;
+  for (size_t i = 0; (i < image->numSegments) && (result); i++) {
+    const MemorySegment_s *segment = &(image->segments[i]);
+    if (segment->numBytes == 0)
+      continue;
+    if (segment->address > address)
+      result = FileWriter_fill(&file, fill, segment->address - address);
+    if (result)
+      result = FileWriter_write(&file, segment->data, segment->numBytes);
+    address = segment->address + segment->numBytes;
+  }
+
+  // for sparse file get actually written size
+  if (file.sizeHoles > 0) {
+    uint64_t countWrite = countByte - file.sizeHoles;
+    if (countWrite > 1024*1024)
+      snprintf(sparse, sizeof(sparse), ", %1.1fMB written", (float) countWrite/1024.0/1024.0);
+    else if (countWrite > 1024)
+      snprintf(sparse, sizeof(sparse), ", %1.1fkB written", (float) countWrite/1024.0);
+    else
+      snprintf(sparse, sizeof(sparse), ", %dB written", (int) countWrite);
   }
 
   // close output file
-  fflush(fp);
-  fclose(fp);
+  if ((!FileWriter_close(&file)) || (!result)) {
+    MemoryImage_free(image);
+    Error("Failed to write file %s with error [%s]", filename, strerror(errno));
+  }
 
   // print message
   if (verbose == SILENT){
@@ -1673,24 +2514,24 @@ void export_file_bin(char *filename, MemoryImage_s *image, const uint8_t verbose
   }
   else if (verbose == INFORM) {
     if (countByte > 1024*1024)
-      printf("done (%1.1fMB)\n", (float) countByte/1024.0/1024.0);
+      printf("done (%1.1fMB%s)\n", (float) countByte/1024.0/1024.0, sparse);
     else if (countByte > 1024)
-      printf("done (%1.1fkB)\n", (float) countByte/1024.0);
+      printf("done (%1.1fkB%s)\n", (float) countByte/1024.0, sparse);
     else if (countByte > 0)
-      printf("done (%dB)\n", (int) countByte);
+      printf("done (%dB%s)\n", (int) countByte, sparse);
     else
       printf("done, no data\n");
   }
   else if (verbose == CHATTY) {
     if (countByte > 1024*1024)
-      printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) countByte/1024.0/1024.0, 
-        (uint64_t) addrStart, (uint64_t) addrStop);
+      printf("done (%1.1fMB in [0x%" PRIX64 "; 0x%" PRIX64 "]%s)\n", (float) countByte/1024.0/1024.0, 
+        (uint64_t) addrStart, (uint64_t) addrStop, sparse);
     else if (countByte > 1024)
-      printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (float) countByte/1024.0, 
-        (uint64_t) addrStart, (uint64_t) addrStop);
+      printf("done (%1.1fkB in [0x%" PRIX64 "; 0x%" PRIX64 "]%s)\n", (float) countByte/1024.0, 
+        (uint64_t) addrStart, (uint64_t) addrStop, sparse);
     else if (countByte > 0)
-      printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "])\n", (int) countByte, 
-        (uint64_t) addrStart, (uint64_t) addrStop);
+      printf("done (%dB in [0x%" PRIX64 "; 0x%" PRIX64 "]%s)\n", (int) countByte, 
+        (uint64_t) addrStart, (uint64_t) addrStop, sparse);
     else
       printf("done, no data\n");
   }
@@ -1700,6 +2541,234 @@ void export_file_bin(char *filename, MemoryImage_s *image, const uint8_t verbose
 
 
 
+/**
+  \fn uint32_t checksum_image(const MemoryImage_s *image, uint32_t *chkBlocks, const int numThreads)
+
+  \param[in]  image       pointer to memory image
+  \param[out] chkBlocks   CRC32 checksums of memory blocks, i.e. image->numSegments entries. May be NULL
+  \param[in]  numThreads  max. number of threads for checksum calculation
+
+  \return CRC32-IEEE checksum over data of all memory blocks, or 0 for empty image
+
+  Calculate CRC32-IEEE checksums of all memory blocks and of the whole image like
+  MemoryImage_checksum_crc32(). Large blocks are split into chunks, which are calculated
+  in parallel and then joined via crc32_join().
+*/
+uint32_t checksum_image(const MemoryImage_s *image, uint32_t *chkBlocks, const int numThreads) {
+
+  ChecksumChunk_s   *chunks = NULL;     // chunks of memory blocks
+  ChecksumWorker_s  *workers = NULL;    // worker threads
+  size_t            numChunks = 0;      // number of chunks
+  size_t            next = 0;           // index of next chunk
+  uint32_t          crcImage = 0;       // checksum of whole image
+
+  // chunk size for distributing data to threads
+  size_t sizeChunk = image->numEntries / (numThreads > 1 ? numThreads : 1);
+  if (sizeChunk < CHECKSUM_CHUNK_MIN)
+    sizeChunk = CHECKSUM_CHUNK_MIN;
+
+  // split memory blocks into chunks
+  for (size_t i = 0; i < image->numSegments; i++)
+    numChunks += (image->segments[i].numBytes + sizeChunk - 1) / sizeChunk;
+  int numWorkers = ((size_t) numThreads < numChunks) ? numThreads : (int) numChunks;
+  if (numChunks > 0) {
+    chunks  = (ChecksumChunk_s*) calloc(numChunks, sizeof(ChecksumChunk_s));
+    workers = (ChecksumWorker_s*) calloc(numWorkers > 0 ? numWorkers : 1, sizeof(ChecksumWorker_s));
+  }
+
+  // empty image or allocation failed -> calculate blocks sequentially
+  if ((chunks == NULL) || (workers == NULL)) {
+    for (size_t i = 0; i < image->numSegments; i++) {
+      const MemorySegment_s *segment = &(image->segments[i]);
+      if (segment->numBytes == 0)
+        continue;
+      uint32_t crc = MemoryImage_checksum_crc32(image, segment->address, segment->address + segment->numBytes - 1);
+      if (chkBlocks != NULL)
+        chkBlocks[i] = crc;
+      crcImage = crc32_join(crcImage, crc, (uint64_t) segment->numBytes * MEMIMAGE_CHK_BYTES);
+    }
+    free(chunks);
+    free(workers);
+    return crcImage;
+  }
+
+  // calculate chunk checksums in parallel
+  numChunks = 0;
+  for (size_t i = 0; i < image->numSegments; i++) {
+    const MemorySegment_s *segment = &(image->segments[i]);
+    for (size_t ofs = 0; ofs < segment->numBytes; ofs += sizeChunk) {
+      size_t len = (segment->numBytes - ofs < sizeChunk) ? segment->numBytes - ofs : sizeChunk;
+      chunks[numChunks].image     = image;
+      chunks[numChunks].addrStart = segment->address + ofs;
+      chunks[numChunks].addrEnd   = segment->address + ofs + len - 1;
+      chunks[numChunks].idxBlock  = i;
+      numChunks++;
+    }
+  }
+  for (int i = 0; i < numWorkers; i++) {
+    workers[i].chunks    = chunks;
+    workers[i].numChunks = numChunks;
+    workers[i].next      = &next;
+  }
+  runParallel(checksum_worker, workers, sizeof(ChecksumWorker_s), numWorkers);
+
+  // join chunk checksums to block and image checksums in address order
+  for (size_t i = 0; i < numChunks; ) {
+    size_t   idxBlock = chunks[i].idxBlock;
+    uint32_t crcBlock = 0;
+    for (; (i < numChunks) && (chunks[i].idxBlock == idxBlock); i++) {
+      uint64_t len = (uint64_t) (chunks[i].addrEnd - chunks[i].addrStart + 1) * MEMIMAGE_CHK_BYTES;
+      crcBlock = crc32_join(crcBlock, chunks[i].crc, len);
+      crcImage = crc32_join(crcImage, chunks[i].crc, len);
+    }
+    if (chkBlocks != NULL)
+      chkBlocks[idxBlock] = crcBlock;
+  }
+
+  // release buffers
+  free(chunks);
+  free(workers);
+
+  return crcImage;
+
+} // checksum_image()
+
+
+
+/**
+  \fn void checksum_blocks(const MemoryImage_s *image, const checksum_t algo, uint8_t *digests, const int numThreads)
+
+  \param[in]  image       pointer to memory image
+  \param[in]  algo        checksum algorithm
+  \param[out] digests     checksums of memory blocks, CHECKSUM_MAX_SIZE bytes per block, i.e. image->numSegments entries
+  \param[in]  numThreads  max. number of threads for checksum calculation
+
+  Calculate checksums of all memory blocks with selected algorithm, see Checksum_final() for format.
+  CRC32-IEEE is calculated via checksum_image(), i.e. large blocks are split into chunks. Other
+  algorithms can't be joined, therefore blocks are distributed to threads. Block data is streamed
+  through the checksum engine without copying. Only CRC32-IEEE supports MEMIMAGE_CHK_INCLUDE_ADDRESS.
+*/
+void checksum_blocks(const MemoryImage_s *image, const checksum_t algo, uint8_t *digests, const int numThreads) {
+
+  ChecksumChunk_s   *chunks = NULL;     // memory blocks
+  ChecksumWorker_s  *workers = NULL;    // worker threads
+  size_t            numBlocks = image->numSegments;
+  size_t            next = 0;           // index of next block
+
+  // CRC32-IEEE -> parallel chunks, then store in big-endian order like Checksum_final()
+  if (algo == CHECKSUM_CRC32) {
+    uint32_t *crc = (uint32_t*) calloc(numBlocks > 0 ? numBlocks : 1, sizeof(uint32_t));
+    if (crc != NULL) {
+      checksum_image(image, crc, numThreads);
+      for (size_t i = 0; i < numBlocks; i++) {
+        for (int j = 0; j < 4; j++)
+          digests[i * CHECKSUM_MAX_SIZE + j] = (uint8_t) (crc[i] >> (24 - 8*j));
+      }
+      free(crc);
+      return;
+    }
+  }
+
+  // distribute blocks to threads
+  int numWorkers = ((size_t) numThreads < numBlocks) ? numThreads : (int) numBlocks;
+  if (numWorkers < 1)
+    numWorkers = 1;
+  chunks  = (ChecksumChunk_s*) calloc(numBlocks > 0 ? numBlocks : 1, sizeof(ChecksumChunk_s));
+  workers = (ChecksumWorker_s*) calloc(numWorkers, sizeof(ChecksumWorker_s));
+
+  // allocation failed -> calculate blocks sequentially
+  if ((chunks == NULL) || (workers == NULL)) {
+    Checksum_s chk;
+    for (size_t i = 0; i < numBlocks; i++) {
+      Checksum_init(&chk, algo);
+      Checksum_update(&chk, image->segments[i].data, image->segments[i].numBytes);
+      Checksum_final(&chk, digests + i * CHECKSUM_MAX_SIZE);
+    }
+    free(chunks);
+    free(workers);
+    return;
+  }
+
+  // calculate block checksums in parallel
+  for (size_t i = 0; i < numBlocks; i++) {
+    chunks[i].image    = image;
+    chunks[i].idxBlock = i;
+  }
+  for (int i = 0; i < numWorkers; i++) {
+    workers[i].chunks    = chunks;
+    workers[i].numChunks = numBlocks;
+    workers[i].next      = &next;
+    workers[i].algo      = algo;
+    workers[i].digests   = digests;
+  }
+  runParallel(digest_worker, workers, sizeof(ChecksumWorker_s), numWorkers);
+
+  // release buffers
+  free(chunks);
+  free(workers);
+
+} // checksum_blocks()
+
+
+
+/**
+  \fn void checksum_window(MemoryImage_s *image, const checksum_t algo, const MEMIMAGE_ADDR_T addrStart, const MEMIMAGE_ADDR_T addrStop, const uint8_t fill, uint8_t *digest)
+
+  \param[in]  image       pointer to memory image
+  \param[in]  algo        checksum algorithm
+  \param[in]  addrStart   first address of window
+  \param[in]  addrStop    last address of window
+  \param[in]  fill        value of addresses without data, e.g. 0xFF for erased flash
+  \param[out] digest      checksum, CHECKSUM_MAX_SIZE bytes
+
+  Calculate one checksum over an address window like a flash verification, i.e. gaps in the image
+  are read as fill value. Gaps are not stored in the image but passed to Checksum_fill(), which
+  skips constant data for CRC and Adler-32. Therefore the effort depends on the data size, not
+  the window size. Address inclusion (MEMIMAGE_CHK_INCLUDE_ADDRESS) is not supported.
+*/
+void checksum_window(MemoryImage_s *image, const checksum_t algo, const MEMIMAGE_ADDR_T addrStart, const MEMIMAGE_ADDR_T addrStop, const uint8_t fill, uint8_t *digest) {
+
+  Checksum_s       chk;
+  MEMIMAGE_ADDR_T  address = addrStart;   // next address to checksum
+  bool             finished = false;      // window end reached
+  size_t           idx;
+
+  // simple checks of address window
+  if (addrStart > addrStop) {
+    MemoryImage_free(image);
+    Error("start address 0x%" PRIX64 " higher than end address 0x%" PRIX64, (uint64_t) addrStart, (uint64_t) addrStop);
+  }
+
+  // loop over memory blocks in window. Fill gap before block, then stream block data
+  Checksum_init(&chk, algo);
+  MemoryImage_getIndex(image, addrStart, &idx);
+  for (; (idx < image->numSegments) && (image->segments[idx].address <= addrStop); idx++) {
+    const MemorySegment_s *segment = &(image->segments[idx]);
+    MEMIMAGE_ADDR_T  segEnd = segment->address + segment->numBytes - 1;
+    if (segEnd < address)
+      continue;
+    MEMIMAGE_ADDR_T  start = (segment->address > address) ? segment->address : address;
+    MEMIMAGE_ADDR_T  end   = (segEnd < addrStop) ? segEnd : addrStop;
+    Checksum_fill(&chk, fill, start - address);
+    Checksum_update(&chk, segment->data + (start - segment->address), (size_t) (end - start + 1));
+    if (end == addrStop) {
+      finished = true;
+      break;
+    }
+    address = end + 1;
+  }
+
+  // fill gap until end of window. Split last byte to avoid overflow for full address range
+  if (!finished) {
+    Checksum_fill(&chk, fill, addrStop - address);
+    Checksum_fill(&chk, fill, 1);
+  }
+  Checksum_final(&chk, digest);
+
+} // checksum_window()
+
+
+
 /**
   \fn void fill_image(MemoryImage_s *image, const MEMIMAGE_ADDR_T addrStart, const MEMIMAGE_ADDR_T addrStop, const uint8_t value, const uint8_t verbose)
 
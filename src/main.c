@@ -19,6 +19,7 @@
 #include <stdint.h>
 #include <errno.h>
 #include "hexfile.h"
+#include "filewriter.h"
 #include "misc.h"
 #include "version.h"
 #define _MAIN_
@@ -26,6 +27,9 @@
 #undef _MAIN_
 
 
+// main() is replaced by test runner for unit tests, see test/main.c
+#if !defined(PIO_UNIT_TESTING)
+
 /**
   \fn int main(int argc, char *argv[])
 
@@ -42,6 +46,9 @@ int main(int argc, char ** argv) {
   char            appname[STRLEN];      // name of application without path
   char            version[100];         // version as string
   int             verbose;              // verbosity level (0=MUTE, 1=SILENT, 2=INFORM, 3=CHATTY)
+  int             numThreads;           // max. number of threads for file import and checksum
+  format_t        format;               // format of next import/export file (FORMAT_UNKNOWN = from extension)
+  uint8_t         binFill;              // fill value for gaps in binary export
   MemoryImage_s   image;                // memory image buffer as list of (addr, value)
   int             printHelp = -1;       // parameter index to print help for
   char            tmp[STRLEN+106];      // misc string buffer
@@ -71,6 +78,7 @@ int main(int argc, char ** argv) {
   g_pauseOnExit         = false;      // no wait for <return> before terminating (dummy)
   g_backgroundOperation = false;      // assume foreground application
   verbose               = INFORM;     // verbosity level medium
+  numThreads            = getNumCores();  // use all CPU cores for import
   
 
   // debug: set memory image debug level
@@ -79,6 +87,15 @@ int main(int argc, char ** argv) {
   #endif
 
 
+  // export to stdout -> print console messages to stderr to keep data clean
+  for (int i=1; i<argc-1; i++) {
+    if ((!strcmp(argv[i], "-export")) && (!strcmp(argv[i+1], "-"))) {
+      FileWriter_setStdout(redirectStdout());
+      break;
+    }
+  }
+
+
   // get app name & version, and change console title
   get_app_name(argv[0], VERSION, appname, version);
   snprintf(tmp, sizeof(tmp), "%s (%s)", appname, version);
@@ -89,6 +106,7 @@ int main(int argc, char ** argv) {
   // 1st pass of commandline arguments: set global parameters, no import/export yet
   /////////////////
 
+  format = FORMAT_UNKNOWN;
   for (int i=1; i<argc; i++) {
 
     // print help
@@ -125,14 +143,56 @@ int main(int argc, char ** argv) {
     } // verbosity
 
 
+    // set max. number of threads for import
+    else if (!strcmp(argv[i], "-threads")) {
+
+      // get number of threads
+      if (i+1<argc) {
+        i++;
+        if ((!isDecString(argv[i])) || (sscanf(argv[i],"%d", &numThreads) <= 0) || (numThreads < 1))
+        {
+          printf("\ncommand '-threads' requires a decimal parameter (>=1)\n");
+          printHelp = i;
+          break;
+        }
+      }
+      else {
+        printf("\ncommand '-threads' requires a decimal parameter (>=1)\n");
+        printHelp = i;
+        break;
+      }
+
+    } // threads
+
+
+    // set format of next import or export file
+    else if (!strcmp(argv[i], "-format")) {
+
+      // get format
+      if ((i+1<argc) && (get_format(argv[i+1]) != FORMAT_UNKNOWN)) {
+        i++;
+        format = get_format(argv[i]);
+      }
+      else {
+        printf("\ncommand '-format' requires a format (s19, ihx, txt, bin)\n");
+        printHelp = i;
+        break;
+      }
+
+    } // format
+
+
     // skip file import. Just check parameter number and offset (bin only)
     else if (!strcmp(argv[i], "-import")) {
 
       // get file name
       if (i+1<argc) {
         i+=1;
-        char *p = strrchr(argv[i], '.');
-        if ((p != NULL ) && ((!strcmp(p, ".bin")) || (!strcmp(p, ".BIN")))) {   // for binary file assert additional address
+        char ext[STRLEN];
+        const char *p = getExtension(argv[i], ext, sizeof(ext));
+        format_t fmt = (format != FORMAT_UNKNOWN) ? format : get_format(p);
+        format = FORMAT_UNKNOWN;
+        if (fmt == FORMAT_BIN) {   // for binary file assert additional address
           if (i+1<argc) {
             i+=1;
             if (!isHexString(argv[i])) {
@@ -146,6 +206,14 @@ int main(int argc, char ** argv) {
             printHelp = i;
             break;
           }
+          if ((i+1<argc) && (isHexString(argv[i+1])))    // optional file offset (hex)
+            i+=1;
+          if ((i+1<argc) && (isHexString(argv[i+1])))    // optional slice length (hex)
+            i+=1;
+        }
+        else if (fmt == FORMAT_UNKNOWN) {   // autodetected format, optional address, offset & length in case of binary (hex)
+          for (int j=0; (j<3) && (i+1<argc) && (isHexString(argv[i+1])); j++)
+            i+=1;
         }
       }
       else {
@@ -161,6 +229,7 @@ int main(int argc, char ** argv) {
     else if (!strcmp(argv[i], "-export")) {
       if (i+1<argc) {
         i+=1;
+        format = FORMAT_UNKNOWN;
       }
       else {
         printf("\ncommand '-export' requires a filename\n");
@@ -170,6 +239,19 @@ int main(int argc, char ** argv) {
     } // export
 
 
+    // skip fill value for binary export. Just check parameter type
+    else if (!strcmp(argv[i], "-binFill")) {
+      if ((i+1<argc) && (isHexString(argv[i+1]))) {
+        i+=1;
+      }
+      else {
+        printf("\ncommand '-binFill' requires a hex parameter\n");
+        printHelp = i;
+        break;
+      }
+    } // binFill
+
+
     // skip print
     else if (!strcmp(argv[i], "-print")) {
       
@@ -178,11 +260,19 @@ int main(int argc, char ** argv) {
     } // print
 
 
-    // skip checksum
+    // skip checksum. Just skip optional algorithm and check optional window parameter type
     else if (!strcmp(argv[i], "-checksum")) {
-      
-      // dummy
-
+      if ((i+1<argc) && (Checksum_getAlgorithm(argv[i+1]) != CHECKSUM_UNKNOWN)) {
+        i+=1;
+      }
+      if ((i+1<argc) && (isHexString(argv[i+1]))) {
+        if ((i+3>=argc) || (!isHexString(argv[i+2])) || (!isHexString(argv[i+3]))) {
+          printf("\ncommand '-checksum' requires three hex parameters for address window\n");
+          printHelp = i;
+          break;
+        }
+        i+=3;
+      }
     } // checksum
 
 
@@ -314,10 +404,15 @@ int main(int argc, char ** argv) {
     printf("usage: %s with following options/commands:\n", appname);
     printf("    -h/-help                            print this help\n");
     printf("    -v/-verbose [level]                 set verbosity level 0..3 (default: 2)\n");
-    printf("    -import [infile [addr]]             import from file to image. For binary file (*.bin) provide start address (in hex)\n");
+    printf("    -threads [num]                      max. number of threads for file import and checksum (default: number of CPU cores)\n");
+    printf("    -format [fmt]                       format of next import/export file (s19, ihx, txt, bin), e.g. for stdin/stdout ('-')\n");
+    printf("    -import [infile [addr [ofs [len]]]] import from file to image. For binary file (*.bin) provide start address and optional file offset & length (in hex)\n");
     printf("    -export [outfile]                   export image to file\n");
+    printf("    -binFill [val]                      fill value for gaps in binary export (hex, default: 0x00 as sparse file)\n");
     printf("    -print                              print image to console\n");
-    printf("    -checksum                           print CRC32-IEEE checksum over data ranges in image\n");
+    printf("    -checksum [algo] [start stop fill]  print checksum over data ranges in image. Optional algorithm: crc32 (default),\n");
+    printf("                                        crc16 (CCITT), crc32c, crc32-mpeg2, adler32, sha256. With hex window [start stop fill]\n");
+    printf("                                        print one checksum over window, with gaps read as fill value (e.g. 0xFF for flash)\n");
     printf("    -fill [addrStart addrStop val]      fill specified range with fixed value (addr & val in hex)\n");
     printf("    -fillRand [addrStart addrStop]      fill specified range with random values in 0-255 (addr in hex)\n");
     printf("    -clip [addrStart addrStop]          clip image to specified range (addr in hex)\n");
@@ -329,7 +424,8 @@ int main(int argc, char ** argv) {
     printf("  - Motorola S19 (*.s19), see https://en.wikipedia.org/wiki/SREC_(file_format)\n");
     printf("  - Intel Hex (*.hex, *.ihx), see https://en.wikipedia.org/wiki/Intel_HEX\n");
     printf("  - ASCII table (*.txt) consisting of lines with 'addr  value' (dec or hex). Lines starting with '#' are ignored\n");
-    printf("  - Binary data (*.bin) with an additional starting address\n");
+    printf("  - Binary data (*.bin) with an additional starting address. Optionally import only slice [ofs; ofs+len-1] of file\n");
+    printf("  - other files are detected by content (e.g. *.srec, *.mot, *.a43). For binary the optional address defaults to 0x0\n");
     printf("\n");
     printf("Supported export formats:\n");
     printf("  - print to stdout (-print)\n");
@@ -338,6 +434,10 @@ int main(int argc, char ** argv) {
     printf("  - ASCII table (*.txt) with 'hexAddr  hexValue'\n");
     printf("  - Binary data (*.bin) without starting address\n");
     printf("\n");
+    printf("Compressed files (*.gz, *.xz) are supported for import and export, if enabled via 'make ZLIB=1 LZMA=1'.\n");
+    printf("File name '-' denotes stdin (import) or stdout (export). When exporting to stdout,\n");
+    printf("console messages are printed to stderr.\n");
+    printf("\n");
     printf("Files are imported and exported in the specified order, i.e. later imports may\n");
     printf("overwrite previous imports. Also outputs only contain the previous imports, i.e.\n");
     printf("intermediate exports only contain the merged content up to that point in time.\n");
@@ -361,6 +461,8 @@ int main(int argc, char ** argv) {
   /////////////////
 
   // loop over commandline arguments
+  format  = FORMAT_UNKNOWN;
+  binFill = 0x00;
   for (int i=1; i<argc; i++) {
 
     // skip print help (already treated in 1st pass)
@@ -375,41 +477,75 @@ int main(int argc, char ** argv) {
     } // verbose
 
 
-    // import next file into memory image
-    else if (!strcmp(argv[i], "-import")) {
+    // skip number of threads (already treated in 1st pass)
+    else if (!strcmp(argv[i], "-threads")) {
+      i+=1;
+    } // threads
 
-      // intermediate variables
-      char      infile[STRLEN]="";     // name of input file
-      uint64_t  addrStart;             // address offset for binary file
 
-      // get file name
-      strncpy(infile, argv[++i], STRLEN-1);
+    // set format of next import or export file (already checked in 1st pass)
+    else if (!strcmp(argv[i], "-format")) {
+      format = get_format(argv[++i]);
+    } // format
 
-      // for binary file also get starting address
-      char *p = strrchr(infile, '.');
-      if ((p != NULL ) && ((strstr(p, ".bin")) || (strstr(p, ".BIN")))) {
-        strncpy(tmp, argv[++i], STRLEN-1);
-        sscanf(tmp, "%" SCNx64, &addrStart);
-      }
 
-      // import file to memory image, depending on type
-      if ((p != NULL ) && ((!strcmp(p, ".s19")) || (!strcmp(p, ".S19")))) {        // Motorola S-record format
-        import_file_s19(infile, &image, verbose);
-      }
-      else if ((p != NULL ) && (!strcmp(p, ".hex") || (!strcmp(p, ".HEX")) || (!strcmp(p, ".ihx")) || (!strcmp(p, ".IHX")))) {  // Intel hex format
-        import_file_ihx(infile, &image, verbose);
-      }
-      else if ((p != NULL ) && ((!strcmp(p, ".txt")) || (!strcmp(p, ".TXT")))) {   // text table (hex addr / data)
-        import_file_txt(infile, &image, verbose);
-      }
-      else if ((p != NULL ) && ((!strcmp(p, ".bin")) || (!strcmp(p, ".BIN")))) {   // binary file
-        import_file_bin(infile, addrStart, &image, verbose);
-      }
-      else {
+    // import files into memory image. Consecutive imports are read concurrently
+    else if (!strcmp(argv[i], "-import")) {
+
+      // intermediate variables
+      ImportFile_s  *files;            // list of consecutive files to import
+      int           numFiles = 0;      // number of files in list
+
+      // allocate file list. Each import requires min. 2 arguments
+      files = (ImportFile_s*) calloc(argc/2 + 1, sizeof(ImportFile_s));
+      if (files == NULL) {
         MemoryImage_free(&image);
-        Error("Input file %s has unsupported format (*.s19, *.hex, *.ihx, *.txt, *.bin)", infile);
+        Error("Failed to allocate file list");
       }
 
+      // collect consecutive imports
+      while (true) {
+
+        // get file name
+        ImportFile_s *file = &(files[numFiles++]);
+        file->filename = argv[++i];
+
+        // get file format from option '-format' or extension. Ignore compression suffix. Else autodetect from content
+        char ext[STRLEN];
+        const char *p = getExtension(file->filename, ext, sizeof(ext));
+        file->format = (format != FORMAT_UNKNOWN) ? format : get_format(p);
+        format = FORMAT_UNKNOWN;
+
+        // for binary file also get starting address. For autodetection optional, default is 0x0
+        if (file->format == FORMAT_BIN) {
+          strncpy(tmp, argv[++i], STRLEN-1);
+          sscanf(tmp, "%" SCNx64, &(file->addrStart));
+        }
+        if ((file->format == FORMAT_BIN) || (file->format == FORMAT_UNKNOWN)) {
+          if ((file->format == FORMAT_UNKNOWN) && (i+1<argc) && (isHexString(argv[i+1])))
+            sscanf(argv[++i], "%" SCNx64, &(file->addrStart));
+          if ((i+1<argc) && (isHexString(argv[i+1])))
+            sscanf(argv[++i], "%" SCNx64, &(file->offset));
+          if ((i+1<argc) && (isHexString(argv[i+1])))
+            sscanf(argv[++i], "%" SCNx64, &(file->length));
+        }
+
+        // next argument is import (optionally with format) -> continue list, else end of list
+        if ((i+1 < argc) && (!strcmp(argv[i+1], "-import")))
+          i++;
+        else if ((i+3 < argc) && (!strcmp(argv[i+1], "-format")) && (!strcmp(argv[i+3], "-import"))) {
+          format = get_format(argv[i+2]);
+          i += 3;
+        }
+        else
+          break;
+
+      } // collect imports
+
+      // import files to memory image. Later files overwrite earlier ones
+      import_files(files, numFiles, &image, numThreads, verbose);
+      free(files);
+
     } // import file
 
 
@@ -422,19 +558,24 @@ int main(int argc, char ** argv) {
       // get file name
       strncpy(outfile, argv[++i], STRLEN-1);
 
-      // export to file with format depending on extension
-      char *p = strrchr(outfile, '.');
-      if ((p != NULL ) && ((!strcmp(p, ".s19")) || (!strcmp(p, ".S19"))))          // Motorola S-record format
+      // get file format from option '-format' or extension. Compression depends on suffix (.gz, .xz)
+      char ext[STRLEN];
+      const char *p = getExtension(outfile, ext, sizeof(ext));
+      format_t fmt = (format != FORMAT_UNKNOWN) ? format : get_format(p);
+      format = FORMAT_UNKNOWN;
+
+      // export to file with format
+      if (fmt == FORMAT_S19)          // Motorola S-record format
         export_file_s19(outfile, &image, verbose);
-      else if ((p != NULL ) && ((!strcmp(p, ".hex")) || (!strcmp(p, ".HEX")) || (!strcmp(p, ".ihx")) || (!strcmp(p, ".IHX"))))  // Intel hex format
+      else if (fmt == FORMAT_IHX)     // Intel hex format
         export_file_ihx(outfile, &image, verbose);
-      else if ((p != NULL ) && ((!strcmp(p, ".txt")) || (!strcmp(p, ".TXT"))))     // text table (hex addr / data)
+      else if (fmt == FORMAT_TXT)     // text table (hex addr / data)
         export_file_txt(outfile, &image, verbose);
-      else if ((p != NULL ) && ((!strcmp(p, ".bin")) || (!strcmp(p, ".BIN"))))     // binary file
-        export_file_bin(outfile, &image, verbose);
+      else if (fmt == FORMAT_BIN)     // binary file
+        export_file_bin(outfile, &image, binFill, verbose);
       else {
         MemoryImage_free(&image);
-        Error("Output file %s has unsupported format (*.s19, *.hex, *.ihx, *.txt, *.bin)", outfile);
+        Error("Output file %s has unsupported format (*.s19, *.hex, *.ihx, *.txt, *.bin or option -format)", outfile);
       }
 
     } // export file
@@ -449,29 +590,75 @@ int main(int argc, char ** argv) {
     } // print memory image
 
 
-    // print CRC32 checksum over image
+    // print checksum over image, default is CRC32-IEEE
     else if (!strcmp(argv[i], "-checksum")) {
 
-      if (MemoryImage_isEmpty(&image)) {
-        printf("  CRC32 chk skipped for empty image\n");
-        break;
+      // get optional algorithm (already checked in 1st pass)
+      checksum_t algo = CHECKSUM_CRC32;
+      if ((i+1<argc) && (Checksum_getAlgorithm(argv[i+1]) != CHECKSUM_UNKNOWN))
+        algo = Checksum_getAlgorithm(argv[++i]);
+
+      // optional address window with fill value for gaps (already checked in 1st pass)
+      if ((i+1<argc) && (isHexString(argv[i+1]))) {
+        uint64_t  addrStart, addrStop, value;
+        uint8_t   digest[CHECKSUM_MAX_SIZE];
+        char      str[2*CHECKSUM_MAX_SIZE+3];
+        strncpy(tmp, argv[++i], STRLEN-1);  sscanf(tmp, "%" SCNx64, &addrStart);
+        strncpy(tmp, argv[++i], STRLEN-1);  sscanf(tmp, "%" SCNx64, &addrStop);
+        strncpy(tmp, argv[++i], STRLEN-1);  sscanf(tmp, "%" SCNx64, &value);
+        checksum_window(&image, algo, addrStart, addrStop, (uint8_t) value, digest);
+        printf("  %s:\n", Checksum_getName(algo));
+        printf("    [0x%04" PRIX64 "; 0x%04" PRIX64 "], fill 0x%02" PRIX8 ": %s\n", addrStart, addrStop, (uint8_t) value,
+          Checksum_toString(algo, digest, str, sizeof(str)));
       }
 
-      // for each consecutive memory range print CRC32 checksum to stdout
-      MEMIMAGE_ADDR_T address = 0x00;
-      size_t          idxStart, idxEnd;
-      printf("  CRC32-IEEE:\n");
-      while (MemoryImage_getMemoryBlock(&image, address, &idxStart, &idxEnd)) {
-        MEMIMAGE_ADDR_T  addrStart = image.memoryEntries[idxStart].address;
-        MEMIMAGE_ADDR_T  addrEnd   = image.memoryEntries[idxEnd].address;
-        uint32_t         chk = MemoryImage_checksum_crc32(&image, idxStart, idxEnd);
-        printf("    [0x%04" PRIX64 "; 0x%04" PRIX64 "]: 0x%08" PRIX32 "\n", (uint64_t) addrStart, (uint64_t) addrEnd, chk);
-        address = addrEnd + 1;
-      }
+      // checksum of each memory block
+      else {
+
+        // empty image -> skip. Keep previous message for default CRC32
+        if (MemoryImage_isEmpty(&image)) {
+          printf("  %s chk skipped for empty image\n", (algo == CHECKSUM_CRC32) ? "CRC32" : Checksum_getName(algo));
+          break;
+        }
+
+        // calculate checksums of all memory ranges in parallel
+        uint8_t *digests = (uint8_t*) calloc(image.numSegments, CHECKSUM_MAX_SIZE);
+        if (digests == NULL) {
+          MemoryImage_free(&image);
+          Error("Failed to allocate checksum buffer");
+        }
+        checksum_blocks(&image, algo, digests, numThreads);
+
+        // for each consecutive memory range print checksum to stdout
+        MEMIMAGE_ADDR_T address = 0x00;
+        size_t          idxBlock;
+        char            str[2*CHECKSUM_MAX_SIZE+3];
+        printf("  %s:\n", Checksum_getName(algo));
+        while (MemoryImage_getMemoryBlock(&image, address, &idxBlock)) {
+          MEMIMAGE_ADDR_T  addrStart = image.segments[idxBlock].address;
+          MEMIMAGE_ADDR_T  addrEnd   = addrStart + image.segments[idxBlock].numBytes - 1;
+          printf("    [0x%04" PRIX64 "; 0x%04" PRIX64 "]: %s\n", (uint64_t) addrStart, (uint64_t) addrEnd,
+            Checksum_toString(algo, digests + idxBlock * CHECKSUM_MAX_SIZE, str, sizeof(str)));
+          address = addrEnd + 1;
+        }
+        free(digests);
+
+      } // checksum of each memory block
 
     } // print checksum
 
 
+    // set fill value for binary export
+    else if (!strcmp(argv[i], "-binFill")) {
+
+      // get fill value for subsequent binary exports
+      uint64_t  value;
+      strncpy(tmp, argv[++i], STRLEN-1);  sscanf(tmp, "%" SCNx64, &value);
+      binFill = (uint8_t) value;
+
+    } // binFill
+
+
     // fill memory range with fixed value
     else if (!strcmp(argv[i], "-fill")) {
 
@@ -577,5 +764,7 @@ int main(int argc, char ** argv) {
 
 } // main
 
+#endif // PIO_UNIT_TESTING
+
 
 // end of file
@@ -24,17 +24,304 @@
 #define MAX(x, y) (((x) > (y)) ? (x) : (y))
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 
+/// chunk size for filling address ranges [B]
+#define MEMIMAGE_CHUNK_SIZE  4096
+
+
+/**********************
+ LOCAL FUNCTIONS
+**********************/
+
+/// @brief assert capacity of segment list, expand if required
+/// @param      image         pointer to memory image
+/// @param[in]  numSegments   required number of segments
+/// @return operation successful
+static bool MemoryImage_reserveSegments(MemoryImage_s* image, const size_t numSegments) {
+
+    // nothing to do
+    if (numSegments <= image->capacity)
+        return true;
+
+    // expand segment list by margin
+    size_t newCapacity = MAX(numSegments, ceil((float) image->capacity * (float) MEMIMAGE_BUFFER_MARGIN));
+
+    // optional debug output
+    #if defined(MEMIMAGE_DEBUG)
+        if (image->debug >= 2) {
+            fprintf(stderr, "MemoryImage_reserveSegments(): resize %d to %d\n", (int) image->capacity, (int) newCapacity);
+        }
+    #endif // MEMIMAGE_DEBUG
+
+    // re-allocate segment list. Return on fail
+    MemorySegment_s* segments = (MemorySegment_s*) realloc(image->segments, newCapacity * sizeof(MemorySegment_s));
+    if (segments == NULL) {
+        fprintf(stderr, "Error in MemoryImage_reserveSegments(): failed to reallocate %ldB\n", (long) (newCapacity * sizeof(MemorySegment_s)));
+        return false;
+    }
+    image->segments = segments;
+    image->capacity = newCapacity;
+
+    // return success
+    return true;
+
+} // MemoryImage_reserveSegments()
+
+
+/// @brief assert data capacity of memory segment, expand if required
+/// @param      segment   pointer to memory segment
+/// @param[in]  numBytes  required number of data bytes
+/// @return operation successful
+static bool MemorySegment_reserve(MemorySegment_s* segment, const size_t numBytes) {
+
+    // nothing to do
+    if (numBytes <= segment->capacity)
+        return true;
+
+    // expand data buffer by margin
+    size_t newCapacity = MAX(numBytes, MIN(ceil((float) segment->capacity * (float) MEMIMAGE_BUFFER_MARGIN), MEMIMAGE_BUFFER_MAX));
+
+    // re-allocate data buffer. Return on fail
+    uint8_t* data = (uint8_t*) realloc(segment->data, newCapacity);
+    if (data == NULL) {
+        fprintf(stderr, "Error in MemorySegment_reserve(): failed to reallocate %ldB\n", (long) newCapacity);
+        return false;
+    }
+    segment->data = data;
+    segment->capacity = newCapacity;
+
+    // return success
+    return true;
+
+} // MemorySegment_reserve()
+
+
+/// @brief release unused data capacity of memory segment, if margin is exceeded
+/// @param      segment   pointer to memory segment
+static void MemorySegment_shrink(MemorySegment_s* segment) {
+
+    // shrink only if unused capacity exceeds margin
+    if ((segment->numBytes == 0) || ((float) segment->numBytes * (float) MEMIMAGE_BUFFER_MARGIN >= (float) segment->capacity))
+        return;
+
+    // re-allocate data buffer. On fail keep old buffer
+    uint8_t* data = (uint8_t*) realloc(segment->data, segment->numBytes);
+    if (data != NULL) {
+        segment->data = data;
+        segment->capacity = segment->numBytes;
+    }
+
+} // MemorySegment_shrink()
+
+
+/// @brief insert empty segment at specified position in segment list
+/// @param      image     pointer to memory image
+/// @param[in]  index     position of new segment
+/// @param[in]  address   start address of new segment
+/// @return operation successful
+static bool MemoryImage_insertSegment(MemoryImage_s* image, const size_t index, const MEMIMAGE_ADDR_T address) {
+
+    // expand segment list, if required
+    if (!MemoryImage_reserveSegments(image, image->numSegments+1))
+        return false;
+
+    // shift higher segments by +1 to free space for new segment
+    if (index < image->numSegments) {
+        memmove(&(image->segments[index+1]), &(image->segments[index]), (image->numSegments - index) * sizeof(MemorySegment_s));
+    }
+    image->numSegments++;
+
+    // initialize new segment
+    MemorySegment_s* segment = &(image->segments[index]);
+    segment->address  = address;
+    segment->data     = NULL;
+    segment->numBytes = 0;
+    segment->capacity = 0;
+
+    // return success
+    return true;
+
+} // MemoryImage_insertSegment()
+
+
+/// @brief remove consecutive segments from segment list and release their data
+/// @param      image     pointer to memory image
+/// @param[in]  index     position of first segment to remove
+/// @param[in]  num       number of segments to remove
+static void MemoryImage_removeSegments(MemoryImage_s* image, const size_t index, const size_t num) {
+
+    // release segment data
+    for (size_t i = index; i < index+num; i++) {
+        free(image->segments[i].data);
+    }
+
+    // shift higher segments by -num
+    if (index+num < image->numSegments) {
+        memmove(&(image->segments[index]), &(image->segments[index+num]), (image->numSegments - index - num) * sizeof(MemorySegment_s));
+    }
+    image->numSegments -= num;
+
+} // MemoryImage_removeSegments()
+
+
+/// @brief join segment with upper neighbour. Segments must be adjacent
+/// @param      image     pointer to memory image
+/// @param[in]  index     position of lower segment
+/// @return operation successful
+static bool MemoryImage_joinSegments(MemoryImage_s* image, const size_t index) {
+
+    MemorySegment_s* lower = &(image->segments[index]);
+    MemorySegment_s* upper = &(image->segments[index+1]);
+
+    // append data of upper segment to lower segment
+    if (!MemorySegment_reserve(lower, lower->numBytes + upper->numBytes))
+        return false;
+    memcpy(lower->data + lower->numBytes, upper->data, upper->numBytes);
+    lower->numBytes += upper->numBytes;
+
+    // remove upper segment
+    MemoryImage_removeSegments(image, index+1, 1);
+
+    // return success
+    return true;
+
+} // MemoryImage_joinSegments()
+
+
+/// @brief check if address is located behind last segment, i.e. data can be appended without search
+/// @param[in]  image     pointer to memory image
+/// @param[in]  address   address to check
+/// @return address behind last segment (or image empty)
+static inline bool MemoryImage_isAppend(const MemoryImage_s* image, const MEMIMAGE_ADDR_T address) {
+
+    // empty image -> append
+    if (image->numSegments == 0)
+        return true;
+
+    // compare with last address in image
+    const MemorySegment_s* last = &(image->segments[image->numSegments-1]);
+    return (address > last->address) && (address - last->address >= last->numBytes);
+
+} // MemoryImage_isAppend()
+
+/// @brief copy data in address range [addrStart;addrEnd] to separate image, shifted to start at addrToStart
+/// @param[in]  image       pointer to memory image
+/// @param[in]  addrStart   start address (inclusive)
+/// @param[in]  addrEnd     end address (inclusive)
+/// @param[in]  addrToStart new address of addrStart
+/// @param      rangeImage  pointer to empty image receiving the range
+/// @return operation successful
+static bool MemoryImage_extractRange(const MemoryImage_s* image, const MEMIMAGE_ADDR_T addrStart, const MEMIMAGE_ADDR_T addrEnd, const MEMIMAGE_ADDR_T addrToStart, MemoryImage_s* rangeImage) {
+
+    // loop over segments overlapping range
+    size_t idx;
+    if ((addrStart > addrEnd) || (!MemoryImage_getMemoryBlock(image, addrStart, &idx)))
+        return true;
+    for (; (idx < image->numSegments) && (image->segments[idx].address <= addrEnd); idx++) {
+        const MemorySegment_s* segment = &(image->segments[idx]);
+
+        // clip segment to range
+        size_t offStart = (segment->address < addrStart) ? (addrStart - segment->address) : 0;
+        size_t offEnd   = segment->numBytes;
+        if (addrEnd - segment->address < segment->numBytes)
+            offEnd = addrEnd - segment->address + 1;
+
+        // add shifted data to range image
+        if (!MemoryImage_addBlock(rangeImage, segment->address + offStart - addrStart + addrToStart, segment->data + offStart, offEnd - offStart))
+            return false;
+    }
+
+    // return success
+    return true;
+
+} // MemoryImage_extractRange()
+
+
+/// @brief sort staged entries by address. Stable LSD radix sort, i.e. order of insertion is kept for identical addresses
+/// @param      staging   pointer to staging buffer
+/// @return operation successful
+static bool MemoryStaging_sort(MemoryStaging_s* staging) {
+
+    size_t          numEntries = staging->numEntries;
+    size_t          count[sizeof(MEMIMAGE_ADDR_T)][256];
+
+    // skip if already sorted, e.g. for ascending imports
+    size_t i = 1;
+    while ((i < numEntries) && (staging->entries[i-1].address <= staging->entries[i].address))
+        i++;
+    if (i >= numEntries)
+        return true;
+
+    // get histograms for all address bytes in a single pass
+    memset(count, 0, sizeof(count));
+    for (i = 0; i < numEntries; i++) {
+        MEMIMAGE_ADDR_T address = staging->entries[i].address;
+        for (size_t j = 0; j < sizeof(MEMIMAGE_ADDR_T); j++) {
+            count[j][(address >> (8*j)) & 0xFF]++;
+        }
+    }
+
+    // allocate buffer for alternating sort passes
+    MemoryEntry_s* tmp = (MemoryEntry_s*) malloc(numEntries * sizeof(MemoryEntry_s));
+    if (tmp == NULL) {
+        fprintf(stderr, "Error in MemoryStaging_sort(): failed to allocate %ldB\n", (long) (numEntries * sizeof(MemoryEntry_s)));
+        return false;
+    }
+    MemoryEntry_s* src = staging->entries;
+    MemoryEntry_s* dest = tmp;
+
+    // sort by address bytes, starting with LSB. Skip bytes which are identical for all entries
+    for (size_t j = 0; j < sizeof(MEMIMAGE_ADDR_T); j++) {
+        if (count[j][(src[0].address >> (8*j)) & 0xFF] == numEntries)
+            continue;
+
+        // convert histogram to start positions
+        size_t pos = 0;
+        for (size_t k = 0; k < 256; k++) {
+            size_t num = count[j][k];
+            count[j][k] = pos;
+            pos += num;
+        }
+
+        // scatter entries to destination buffer
+        for (i = 0; i < numEntries; i++) {
+            dest[count[j][(src[i].address >> (8*j)) & 0xFF]++] = src[i];
+        }
+
+        // swap buffers for next pass
+        MemoryEntry_s* swap = src;
+        src = dest;
+        dest = swap;
+    }
+
+    // keep buffer with sorted entries, release other
+    if (src != staging->entries) {
+        free(staging->entries);
+        staging->entries = src;
+        staging->capacity = numEntries;
+    }
+    else {
+        free(tmp);
+    }
+
+    // return success
+    return true;
+
+} // MemoryStaging_sort()
+
 
 /**********************
  GLOBAL FUNCTIONS
 **********************/
 
 void MemoryImage_init(MemoryImage_s* image) {
-    
+
     // initialize struct variables
-    image->memoryEntries = NULL;
-    image->numEntries = 0;
+    image->segments = NULL;
+    image->numSegments = 0;
     image->capacity = 0;
+    image->numEntries = 0;
+    image->countAppend = 0;
+    image->countSearch = 0;
     #if defined(MEMIMAGE_DEBUG)
         image->debug = 0;
     #endif
@@ -43,14 +330,20 @@ void MemoryImage_init(MemoryImage_s* image) {
 
 
 void MemoryImage_free(MemoryImage_s* image) {
-    
-    // release memory buffer 
-    free(image->memoryEntries);
+
+    // release segment data and segment list
+    for (size_t i = 0; i < image->numSegments; i++) {
+        free(image->segments[i].data);
+    }
+    free(image->segments);
 
     // reset struct variables
-    image->memoryEntries = NULL;
-    image->numEntries = 0;
+    image->segments = NULL;
+    image->numSegments = 0;
     image->capacity = 0;
+    image->numEntries = 0;
+    image->countAppend = 0;
+    image->countSearch = 0;
     #if defined(MEMIMAGE_DEBUG)
         image->debug = 0;
     #endif
@@ -59,31 +352,35 @@ void MemoryImage_free(MemoryImage_s* image) {
 
 
 bool MemoryImage_isEmpty(const MemoryImage_s* image) {
-    
+
     // check if memory image is empty
-    if ((image->memoryEntries == NULL) || (image->numEntries == 0) || (image->capacity < image->numEntries))
+    if ((image->segments == NULL) || (image->numSegments == 0) || (image->numEntries == 0))
         return true;
 
     // memory image contains data
     return false;
 
-} // MemoryImage_free()
+} // MemoryImage_isEmpty()
 
 
 void MemoryImage_print(const MemoryImage_s* image, FILE* fp) {
-    
+
     // optional debug output
     #if defined(MEMIMAGE_DEBUG)
         if (image->debug >= 1) {
-            fprintf(fp, "MemoryImage_print(): numEntries=%ld, capacity=%ld\n", (long) image->numEntries, (long) image->capacity);
+            fprintf(fp, "MemoryImage_print(): numEntries=%ld, numSegments=%ld, capacity=%ld\n", (long) image->numEntries, (long) image->numSegments, (long) image->capacity);
+            fprintf(fp, "MemoryImage_print(): countAppend=%ld, countSearch=%ld\n", (long) image->countAppend, (long) image->countSearch);
             fprintf(fp, "\n");
             fprintf(fp, "address\tdata\n");
         }
     #endif // MEMIMAGE_DEBUG
 
     // loop over image and output address, data in hex format
-    for (size_t i = 0; i < image->numEntries; i++) {
-        fprintf(fp, "0x%04" PRIX64 "\t0x%02" PRIX8 "\n", (uint64_t) image->memoryEntries[i].address, (uint8_t) image->memoryEntries[i].data);
+    for (size_t i = 0; i < image->numSegments; i++) {
+        const MemorySegment_s* segment = &(image->segments[i]);
+        for (size_t j = 0; j < segment->numBytes; j++) {
+            fprintf(fp, "0x%04" PRIX64 "\t0x%02" PRIX8 "\n", (uint64_t) (segment->address + j), (uint8_t) segment->data[j]);
+        }
     }
     fflush(fp);
 
@@ -92,7 +389,7 @@ void MemoryImage_print(const MemoryImage_s* image, FILE* fp) {
 
 #if defined(MEMIMAGE_DEBUG)
     void MemoryImage_setDebug(MemoryImage_s* image, const uint8_t debug) {
-        
+
         // optional debug output
         if (image->debug == 2) {
             fprintf(stderr, "MemoryImage_setDebug(): debug=%d\n", (int) debug);
@@ -106,61 +403,79 @@ void MemoryImage_print(const MemoryImage_s* image, FILE* fp) {
 
 
 bool MemoryImage_addData(MemoryImage_s* image, const MEMIMAGE_ADDR_T address, const uint8_t data) {
-    
-    // if address already exists, replace content and return
+
     size_t idx;
-    if (MemoryImage_getIndex(image, address, &idx)) {
-        image->memoryEntries[idx].data = data;
-        #if defined(MEMIMAGE_DEBUG)
-            if (image->debug >= 1) {
-                fprintf(stderr, "MemoryImage_addData(): 0x%04" PRIX64 " 0x%02" PRIX8 " -> overwrite %d\n", (uint64_t) address, (uint8_t) data, (int) idx);
-            }
-        #endif // MEMIMAGE_DEBUG
-        return true;
+
+    // fast path: address behind last segment -> append without search
+    if (MemoryImage_isAppend(image, address)) {
+        idx = image->numSegments;
+        image->countAppend++;
+    }
+
+    // else search segment. If address already exists, replace content and return
+    else {
+        image->countSearch++;
+        if (MemoryImage_getIndex(image, address, &idx)) {
+            MemorySegment_s* segment = &(image->segments[idx]);
+            segment->data[address - segment->address] = data;
+            #if defined(MEMIMAGE_DEBUG)
+                if (image->debug >= 1) {
+                    fprintf(stderr, "MemoryImage_addData(): 0x%04" PRIX64 " 0x%02" PRIX8 " -> overwrite segment %d\n", (uint64_t) address, (uint8_t) data, (int) idx);
+                }
+            #endif // MEMIMAGE_DEBUG
+            return true;
+        }
     }
 
     // assert buffer size limit
-    if ((image->numEntries+1) * sizeof(MemoryEntry_s) > MEMIMAGE_BUFFER_MAX) {
+    if (image->numEntries+1 > MEMIMAGE_BUFFER_MAX) {
         fprintf(stderr, "Error in MemoryImage_addData(): buffer size limit of %gMB reached\n", (float) MEMIMAGE_BUFFER_MAX/(1024.0*1024.0));
         return false;
     }
 
-    // expand memory buffer, if required
-    if (image->numEntries+1 >= image->capacity) {
-        size_t newCapacity = MAX(image->numEntries+1, MIN(ceil((float) image->capacity * (float) MEMIMAGE_BUFFER_MARGIN), MEMIMAGE_BUFFER_MAX));
-
-        // optional debug output
-        #if defined(MEMIMAGE_DEBUG)
-            if (image->debug >= 2) {
-                fprintf(stderr, "MemoryImage_addData(): resize %d to %d\n", (int) image->capacity, (int) newCapacity);
-            }
-        #endif // MEMIMAGE_DEBUG
-
-        // re-allocate memory buffer. Return on fail
-        image->memoryEntries = (MemoryEntry_s*)realloc(image->memoryEntries, newCapacity * sizeof(MemoryEntry_s));
-        if (image->memoryEntries == NULL) {
-            fprintf(stderr, "Error in MemoryImage_addData(): failed to reallocate %ldB\n", newCapacity * (long) sizeof(MemoryEntry_s));
+    // address directly follows lower neighbour -> append to lower segment
+    if ((idx > 0) && (image->segments[idx-1].address + image->segments[idx-1].numBytes == address)) {
+        MemorySegment_s* segment = &(image->segments[idx-1]);
+        if (!MemorySegment_reserve(segment, segment->numBytes+1))
             return false;
+        segment->data[segment->numBytes++] = data;
+
+        // if gap to upper neighbour is closed, join both segments
+        if ((idx < image->numSegments) && (image->segments[idx].address == address+1)) {
+            if (!MemoryImage_joinSegments(image, idx-1))
+                return false;
         }
-        image->capacity = newCapacity;
+    }
 
+    // address directly precedes upper neighbour -> prepend to upper segment
+    else if ((idx < image->numSegments) && (image->segments[idx].address == address+1)) {
+        MemorySegment_s* segment = &(image->segments[idx]);
+        if (!MemorySegment_reserve(segment, segment->numBytes+1))
+            return false;
+        memmove(segment->data+1, segment->data, segment->numBytes);
+        segment->data[0] = data;
+        segment->address = address;
+        segment->numBytes++;
     }
 
-    // shift higher addresses by +1 to free space for new entry
-    if (idx < image->numEntries) {
-        memcpy(&(image->memoryEntries[idx+1L]), &(image->memoryEntries[idx]), (image->numEntries - idx) * (size_t) (sizeof(MemoryEntry_s)));
+    // address is isolated -> add new segment at correct location
+    else {
+        if (!MemoryImage_insertSegment(image, idx, address))
+            return false;
+        MemorySegment_s* segment = &(image->segments[idx]);
+        if (!MemorySegment_reserve(segment, 1)) {
+            MemoryImage_removeSegments(image, idx, 1);
+            return false;
+        }
+        segment->data[0] = data;
+        segment->numBytes = 1;
     }
-    
-    // add new entry at correct location
-    MemoryEntry_s* entry = &(image->memoryEntries[idx]);
-    entry->address = address;
-    entry->data = data;
     image->numEntries++;
 
     // optional debug output
     #if defined(MEMIMAGE_DEBUG)
         if (image->debug >= 1) {
-            fprintf(stderr, "MemoryImage_addData(): 0x%04" PRIX64 " 0x%02" PRIX8 " -> insert %d\n", (uint64_t) address, (uint8_t) data, (int) idx);
+            fprintf(stderr, "MemoryImage_addData(): 0x%04" PRIX64 " 0x%02" PRIX8 " -> insert near segment %d\n", (uint64_t) address, (uint8_t) data, (int) idx);
         }
     #endif // MEMIMAGE_DEBUG
 
@@ -176,39 +491,52 @@ bool MemoryImage_deleteData(MemoryImage_s* image, const MEMIMAGE_ADDR_T address)
     size_t idx;
     if (MemoryImage_getIndex(image, address, &idx)) {
 
+        MemorySegment_s* segment = &(image->segments[idx]);
+        size_t offset = address - segment->address;
+
         // optional debug output
         #if defined(MEMIMAGE_DEBUG)
             if (image->debug >= 1) {
-                fprintf(stderr, "MemoryImage_deleteData(): 0x%04" PRIX64 " -> delete %d\n", (uint64_t) address, (int) idx);
+                fprintf(stderr, "MemoryImage_deleteData(): 0x%04" PRIX64 " -> delete from segment %d\n", (uint64_t) address, (int) idx);
             }
         #endif // MEMIMAGE_DEBUG
 
-        // shift all following elements left to remove original entry
-        for (size_t j = idx; j < image->numEntries - 1; j++) {
-            image->memoryEntries[j] = image->memoryEntries[j + 1];
+        // single byte segment -> remove segment
+        if (segment->numBytes == 1) {
+            MemoryImage_removeSegments(image, idx, 1);
         }
-        image->numEntries--;
 
-        // shrink memory buffer if possible
-        if ((image->capacity > 1) && (floor(image->numEntries * (float) MEMIMAGE_BUFFER_MARGIN) <= (float) image->capacity)) {
-            size_t newCapacity = MAX(1, image->numEntries);
+        // first byte -> shift segment data left by 1
+        else if (offset == 0) {
+            memmove(segment->data, segment->data+1, segment->numBytes-1);
+            segment->address++;
+            segment->numBytes--;
+            MemorySegment_shrink(segment);
+        }
 
-            // optional debug output
-            #if defined(MEMIMAGE_DEBUG)
-                if (image->debug >= 2) {
-                    fprintf(stderr, "MemoryImage_deleteData(): resize %d to %d\n", (int) image->capacity, (int) newCapacity);
-                }
-            #endif // MEMIMAGE_DEBUG
+        // last byte -> just shorten segment
+        else if (offset == segment->numBytes-1) {
+            segment->numBytes--;
+            MemorySegment_shrink(segment);
+        }
 
-            // re-allocate memory buffer. Return on fail
-            image->memoryEntries = (MemoryEntry_s*)realloc(image->memoryEntries, newCapacity * sizeof(MemoryEntry_s));
-            if (image->memoryEntries == NULL) {
-                fprintf(stderr, "Error in MemoryImage_deleteData(): failed to reallocate %ldB\n", newCapacity * (long) sizeof(MemoryEntry_s));
+        // byte inside segment -> split segment into two
+        else {
+            if (!MemoryImage_insertSegment(image, idx+1, address+1))
+                return false;
+            segment = &(image->segments[idx]);      // segment list may have moved
+            MemorySegment_s* upper = &(image->segments[idx+1]);
+            size_t numUpper = segment->numBytes - offset - 1;
+            if (!MemorySegment_reserve(upper, numUpper)) {
+                MemoryImage_removeSegments(image, idx+1, 1);
                 return false;
             }
-            image->capacity = newCapacity;
-
+            memcpy(upper->data, segment->data + offset + 1, numUpper);
+            upper->numBytes = numUpper;
+            segment->numBytes = offset;
+            MemorySegment_shrink(segment);
         }
+        image->numEntries--;
 
         // deletion was successful
         return true;
@@ -226,16 +554,210 @@ bool MemoryImage_deleteData(MemoryImage_s* image, const MEMIMAGE_ADDR_T address)
 
 } // MemoryImage_deleteData()
 
+bool MemoryImage_deleteRange(MemoryImage_s* image, const MEMIMAGE_ADDR_T addrStart, const MEMIMAGE_ADDR_T addrEnd) {
+
+    // optional debug output
+    #if defined(MEMIMAGE_DEBUG)
+        if (image->debug >= 1) {
+            fprintf(stderr, "MemoryImage_deleteRange(): 0x%04" PRIX64 " 0x%04" PRIX64 "\n", (uint64_t) addrStart, (uint64_t) addrEnd);
+        }
+    #endif // MEMIMAGE_DEBUG
+
+    // empty range or image -> nothing to do
+    if ((addrStart > addrEnd) || (image->numSegments == 0))
+        return true;
+
+    // find segments containing (or following) range boundaries
+    size_t idxStart, idxEnd;
+    bool   foundStart = MemoryImage_getIndex(image, addrStart, &idxStart);
+    bool   foundEnd   = MemoryImage_getIndex(image, addrEnd, &idxEnd);
+
+    // check if lower / upper boundary segment is only partially inside range
+    bool   keepHead = foundStart && (image->segments[idxStart].address < addrStart);
+    bool   keepTail = foundEnd && (addrEnd - image->segments[idxEnd].address + 1 < image->segments[idxEnd].numBytes);
+
+    // range strictly inside single segment -> split segment into two
+    if (keepHead && keepTail && (idxStart == idxEnd)) {
+        if (!MemoryImage_insertSegment(image, idxStart+1, addrEnd+1))
+            return false;
+        MemorySegment_s* lower = &(image->segments[idxStart]);
+        MemorySegment_s* upper = &(image->segments[idxStart+1]);
+        size_t offStart = addrStart - lower->address;
+        size_t offEnd   = addrEnd - lower->address + 1;
+        size_t numUpper = lower->numBytes - offEnd;
+        if (!MemorySegment_reserve(upper, numUpper)) {
+            MemoryImage_removeSegments(image, idxStart+1, 1);
+            return false;
+        }
+        memcpy(upper->data, lower->data + offEnd, numUpper);
+        upper->numBytes = numUpper;
+        lower->numBytes = offStart;
+        MemorySegment_shrink(lower);
+        image->numEntries -= offEnd - offStart;
+        return true;
+    }
+
+    // lower boundary segment partially inside range -> truncate segment
+    size_t idxFirst = idxStart;
+    if (keepHead) {
+        MemorySegment_s* segment = &(image->segments[idxStart]);
+        size_t numKeep = addrStart - segment->address;
+        image->numEntries -= segment->numBytes - numKeep;
+        segment->numBytes = numKeep;
+        MemorySegment_shrink(segment);
+        idxFirst++;
+    }
+
+    // upper boundary segment partially inside range -> remove leading data
+    size_t idxLast = (foundEnd) ? idxEnd+1 : idxEnd;
+    if (keepTail) {
+        MemorySegment_s* segment = &(image->segments[idxEnd]);
+        size_t numRemove = addrEnd - segment->address + 1;
+        memmove(segment->data, segment->data + numRemove, segment->numBytes - numRemove);
+        segment->address  += numRemove;
+        segment->numBytes -= numRemove;
+        image->numEntries -= numRemove;
+        MemorySegment_shrink(segment);
+        idxLast--;
+    }
+
+    // remove segments fully inside range at once
+    if (idxLast > idxFirst) {
+        for (size_t i = idxFirst; i < idxLast; i++)
+            image->numEntries -= image->segments[i].numBytes;
+        MemoryImage_removeSegments(image, idxFirst, idxLast - idxFirst);
+    }
+
+    // return success
+    return true;
+
+} // MemoryImage_deleteRange()
+
+
+bool MemoryImage_addBlock(MemoryImage_s* image, const MEMIMAGE_ADDR_T address, const uint8_t *buf, const size_t len) {
+
+    // optional debug output
+    #if defined(MEMIMAGE_DEBUG)
+        if (image->debug >= 1) {
+            fprintf(stderr, "MemoryImage_addBlock(): 0x%04" PRIX64 " %ldB\n", (uint64_t) address, (long) len);
+        }
+    #endif // MEMIMAGE_DEBUG
+
+    // nothing to do
+    if (len == 0)
+        return true;
+
+    // assert address range doesn't wrap around
+    MEMIMAGE_ADDR_T addrEnd = address + (len - 1);
+    if (addrEnd < address) {
+        fprintf(stderr, "Error in MemoryImage_addBlock(): address range 0x%04" PRIX64 " + %ldB exceeds address space\n", (uint64_t) address, (long) len);
+        return false;
+    }
+
+    // find first segment overlapping or touching the new block. For block behind last segment skip search
+    size_t idxFirst;
+    if (MemoryImage_isAppend(image, address)) {
+        idxFirst = image->numSegments;
+        image->countAppend++;
+    }
+    else {
+        MemoryImage_getIndex(image, address, &idxFirst);
+        image->countSearch++;
+    }
+    if ((idxFirst > 0) && (image->segments[idxFirst-1].address + image->segments[idxFirst-1].numBytes == address)) {
+        idxFirst--;
+    }
+
+    // find end of segments overlapping or touching the new block (exclusive). Count bytes to be replaced
+    size_t idxEnd = idxFirst;
+    size_t numOld = 0;
+    while ((idxEnd < image->numSegments) && ((image->segments[idxEnd].address <= addrEnd) || (image->segments[idxEnd].address - 1 == addrEnd))) {
+        numOld += image->segments[idxEnd].numBytes;
+        idxEnd++;
+    }
+
+    // no segment affected -> add new segment containing block
+    if (idxFirst == idxEnd) {
+
+        // assert buffer size limit
+        if (image->numEntries + len > MEMIMAGE_BUFFER_MAX) {
+            fprintf(stderr, "Error in MemoryImage_addBlock(): buffer size limit of %gMB reached\n", (float) MEMIMAGE_BUFFER_MAX/(1024.0*1024.0));
+            return false;
+        }
+
+        // insert new segment and copy data
+        if (!MemoryImage_insertSegment(image, idxFirst, address))
+            return false;
+        MemorySegment_s* segment = &(image->segments[idxFirst]);
+        if (!MemorySegment_reserve(segment, len)) {
+            MemoryImage_removeSegments(image, idxFirst, 1);
+            return false;
+        }
+        memcpy(segment->data, buf, len);
+        segment->numBytes = len;
+        image->numEntries += len;
+
+        // return success
+        return true;
+    }
+
+    // get address range of merged segment
+    MemorySegment_s* first = &(image->segments[idxFirst]);
+    MemorySegment_s* last  = &(image->segments[idxEnd-1]);
+    MEMIMAGE_ADDR_T  addrFirst = MIN(first->address, address);
+    MEMIMAGE_ADDR_T  addrLast  = MAX(last->address + (last->numBytes - 1), addrEnd);
+    size_t           numNew    = (size_t) (addrLast - addrFirst) + 1;
+
+    // assert buffer size limit
+    if (image->numEntries - numOld + numNew > MEMIMAGE_BUFFER_MAX) {
+        fprintf(stderr, "Error in MemoryImage_addBlock(): buffer size limit of %gMB reached\n", (float) MEMIMAGE_BUFFER_MAX/(1024.0*1024.0));
+        return false;
+    }
+
+    // first segment is reused for merged segment
+    if (!MemorySegment_reserve(first, numNew))
+        return false;
+
+    // block starts before first segment -> move part of first segment behind block to final position
+    if (address < first->address) {
+        MEMIMAGE_ADDR_T firstEnd = first->address + (first->numBytes - 1);
+        if (firstEnd > addrEnd) {
+            memmove(first->data + (addrEnd + 1 - addrFirst), first->data + (addrEnd + 1 - first->address), (size_t) (firstEnd - addrEnd));
+        }
+    }
+
+    // copy part of last segment behind block. Segments in between are completely overwritten
+    if (idxEnd-1 > idxFirst) {
+        MEMIMAGE_ADDR_T lastEnd = last->address + (last->numBytes - 1);
+        if (lastEnd > addrEnd) {
+            memcpy(first->data + (addrEnd + 1 - addrFirst), last->data + (addrEnd + 1 - last->address), (size_t) (lastEnd - addrEnd));
+        }
+    }
+
+    // copy new block
+    memcpy(first->data + (address - addrFirst), buf, len);
+    first->address  = addrFirst;
+    first->numBytes = numNew;
+
+    // remove merged segments in one step
+    MemoryImage_removeSegments(image, idxFirst+1, idxEnd-idxFirst-1);
+    image->numEntries = image->numEntries - numOld + numNew;
+
+    // return success
+    return true;
+
+} // MemoryImage_addBlock()
+
 
 bool MemoryImage_getData(const MemoryImage_s* image, const MEMIMAGE_ADDR_T address, uint8_t *data) {
-    
+
     // search for address. If exists, return data
     size_t idx;
     if (MemoryImage_getIndex(image, address, &idx)) {
-        *data = image->memoryEntries[idx].data;
+        *data = image->segments[idx].data[address - image->segments[idx].address];
         #if defined(MEMIMAGE_DEBUG)
             if (image->debug >= 1) {
-                fprintf(stderr, "MemoryImage_getData(): 0x%04" PRIX64 " -> index %d, value 0x%02" PRIX8 "\n", (uint64_t) address, (int) idx, (uint8_t) *data);
+                fprintf(stderr, "MemoryImage_getData(): 0x%04" PRIX64 " -> segment %d, value 0x%02" PRIX8 "\n", (uint64_t) address, (int) idx, (uint8_t) *data);
             }
         #endif // MEMIMAGE_DEBUG
         return true;
@@ -253,6 +775,55 @@ bool MemoryImage_getData(const MemoryImage_s* image, const MEMIMAGE_ADDR_T addre
 } // MemoryImage_getData()
 
 
+bool MemoryImage_getBlock(const MemoryImage_s* image, const MEMIMAGE_ADDR_T address, uint8_t *buf, const size_t len) {
+
+    bool    result = true;
+    size_t  pos = 0;
+
+    // find first segment containing or following address
+    size_t idx;
+    MemoryImage_getIndex(image, address, &idx);
+
+    // copy data from segments. Fill gaps with 0x00
+    while (pos < len) {
+
+        // no more data -> fill remaining buffer
+        if ((idx >= image->numSegments) || ((image->segments[idx].address > address) && (image->segments[idx].address - address >= len))) {
+            memset(buf + pos, 0x00, len - pos);
+            return false;
+        }
+        const MemorySegment_s* segment = &(image->segments[idx]);
+
+        // fill gap before segment
+        if (segment->address > address + pos) {
+            size_t numGap = (size_t) (segment->address - address) - pos;
+            memset(buf + pos, 0x00, numGap);
+            pos += numGap;
+            result = false;
+        }
+
+        // copy segment data
+        size_t offset = (size_t) (address + pos - segment->address);
+        size_t num    = MIN(segment->numBytes - offset, len - pos);
+        memcpy(buf + pos, segment->data + offset, num);
+        pos += num;
+        idx++;
+
+    } // loop over buffer
+
+    // optional debug output
+    #if defined(MEMIMAGE_DEBUG)
+        if (image->debug >= 1) {
+            fprintf(stderr, "MemoryImage_getBlock(): 0x%04" PRIX64 " %ldB -> %s\n", (uint64_t) address, (long) len, result ? "complete" : "incomplete");
+        }
+    #endif // MEMIMAGE_DEBUG
+
+    // return true only if all data was found
+    return result;
+
+} // MemoryImage_getBlock()
+
+
 bool MemoryImage_getIndex(const MemoryImage_s* image, const MEMIMAGE_ADDR_T address, size_t *index) {
 
     // handle empty image separately
@@ -265,14 +836,19 @@ bool MemoryImage_getIndex(const MemoryImage_s* image, const MEMIMAGE_ADDR_T addr
         #endif // MEMIMAGE_DEBUG
         return false;
     }
-    
-    // search for address using binary search. If exists, return index
+
+    // search for segment containing address using binary search. If exists, return index
     int64_t low = 0;
-    int64_t high = image->numEntries - 1;
+    int64_t high = image->numSegments - 1;
     int64_t mid;
     while (low <= high) {
         mid = low + (high - low) / 2;
-        if (image->memoryEntries[mid].address == address) {
+        const MemorySegment_s* segment = &(image->segments[mid]);
+        if (address < segment->address) {
+            high = mid - 1;
+        } else if (address - segment->address >= segment->numBytes) {
+            low = mid + 1;
+        } else {
             *index = mid;
             #if defined(MEMIMAGE_DEBUG)
                 if (image->debug >= 2) {
@@ -281,13 +857,8 @@ bool MemoryImage_getIndex(const MemoryImage_s* image, const MEMIMAGE_ADDR_T addr
             #endif // MEMIMAGE_DEBUG
             return true;
         }
-        if (image->memoryEntries[mid].address < address) {
-            low = mid + 1;
-        } else {
-            high = mid - 1;
-        }
     }
-    
+
     // address not found -> return index of upper neighbour
     *index = low;
     #if defined(MEMIMAGE_DEBUG)
@@ -300,7 +871,7 @@ bool MemoryImage_getIndex(const MemoryImage_s* image, const MEMIMAGE_ADDR_T addr
 } // MemoryImage_getIndex()
 
 
-bool MemoryImage_getMemoryBlock(const MemoryImage_s* image, const MEMIMAGE_ADDR_T addrStart, size_t *idxStart, size_t *idxEnd) {
+bool MemoryImage_getMemoryBlock(const MemoryImage_s* image, const MEMIMAGE_ADDR_T addrStart, size_t *idxSegment) {
 
     // handle empty image separately
     if (MemoryImage_isEmpty(image)) {
@@ -309,36 +880,18 @@ bool MemoryImage_getMemoryBlock(const MemoryImage_s* image, const MEMIMAGE_ADDR_
                 fprintf(stderr, "MemoryImage_getMemoryBlock(): empty image\n");
             }
         #endif // MEMIMAGE_DEBUG
-        *idxStart = 0x00;
-        *idxEnd   = 0x00;
+        *idxSegment = 0;
         return false;
     }
 
-    // find start index of next memory block, abort on error (e.g. end of image reached)
-    MemoryImage_getIndex(image, addrStart, idxStart);
-    if (*idxStart == image->numEntries) {
-        #if defined(MEMIMAGE_DEBUG)
-            if (image->debug >= 2) {
-                fprintf(stderr, "MemoryImage_getMemoryBlock(): end reached at address 0x%04" PRIX64 "\n", (uint64_t) addrStart);
-            }
-        #endif // MEMIMAGE_DEBUG
-    }
-
-    // find last index of next memory block
-    MEMIMAGE_ADDR_T addrLast = image->memoryEntries[*idxStart].address;
-    size_t idx =*idxStart+1;
-    while ((idx < image->numEntries) && (image->memoryEntries[idx].address == addrLast+1))
-    {
-        idx++;
-        addrLast++;
-    }
-    *idxEnd = idx-1; 
+    // find segment containing or following addrStart. Segments are maximal, i.e. each segment is one block
+    MemoryImage_getIndex(image, addrStart, idxSegment);
 
     // check if block found
-    if (*idxEnd == image->numEntries) {
+    if (*idxSegment == image->numSegments) {
         #if defined(MEMIMAGE_DEBUG)
             if (image->debug >= 2) {
-                fprintf(stderr, "MemoryImage_getMemoryBlock(): end reached at index %d\n", (int) *idxEnd);
+                fprintf(stderr, "MemoryImage_getMemoryBlock(): end reached at address 0x%04" PRIX64 "\n", (uint64_t) addrStart);
             }
         #endif // MEMIMAGE_DEBUG
         return false;
@@ -350,54 +903,76 @@ bool MemoryImage_getMemoryBlock(const MemoryImage_s* image, const MEMIMAGE_ADDR_
 } // MemoryImage_getMemoryBlock()
 
 
-uint32_t MemoryImage_checksum_crc32(const MemoryImage_s* image, const size_t idxStart, const size_t idxEnd) {
+MEMIMAGE_ADDR_T MemoryImage_getFirstAddress(const MemoryImage_s* image) {
+
+    // handle empty image separately
+    if (MemoryImage_isEmpty(image))
+        return 0;
+
+    // start of first segment
+    return image->segments[0].address;
+
+} // MemoryImage_getFirstAddress()
+
+
+MEMIMAGE_ADDR_T MemoryImage_getLastAddress(const MemoryImage_s* image) {
+
+    // handle empty image separately
+    if (MemoryImage_isEmpty(image))
+        return 0;
+
+    // end of last segment
+    const MemorySegment_s* segment = &(image->segments[image->numSegments-1]);
+    return segment->address + segment->numBytes - 1;
+
+} // MemoryImage_getLastAddress()
+
+
+uint32_t MemoryImage_checksum_crc32(const MemoryImage_s* image, const MEMIMAGE_ADDR_T addrStart, const MEMIMAGE_ADDR_T addrEnd) {
 
     // initialize CRC32 checksum
     uint32_t crc = 0xFFFFFFFF;
 
-    // loop over specified memory range 
-    for (size_t i = idxStart; i <= idxEnd; i++) {
+    // find first segment in address range
+    size_t idx;
+    MemoryImage_getIndex(image, addrStart, &idx);
+
+    // loop over segments in specified address range
+    for (; (idx < image->numSegments) && (image->segments[idx].address <= addrEnd); idx++) {
 
-        // optionally update CRC32 with address
+        // get part of segment inside address range
+        const MemorySegment_s* segment = &(image->segments[idx]);
+        size_t offsetStart = (addrStart > segment->address) ? (size_t) (addrStart - segment->address) : 0;
+        size_t offsetEnd   = MIN(segment->numBytes - 1, (size_t) (addrEnd - segment->address));
+
+        if (offsetStart > offsetEnd)
+            continue;
+
+        // optionally update CRC32 with address and data of each byte
         #if defined(MEMIMAGE_CHK_INCLUDE_ADDRESS)
-            
-            // add address bytes in order depending on endianness
-            for (int j = 0; j < sizeof(MEMIMAGE_ADDR_T); j++) {
-                
-                uint8_t     byte  = 0;
-                uint16_t    val16 = 1;  // to check machine endianness
-
-                // get next byte (little endian)
-                if (*((uint8_t*) &val16) == 1)
-                    byte = (image->memoryEntries[i].address >> (j * 8)) & 0xFF;
-                
-                // get next byte (big endian)
-                else
-                    byte = (image->memoryEntries[i].address >> ((sizeof(MEMIMAGE_ADDR_T) - 1 - j) * 8)) & 0xFF;
-                
-                // Update CRC32 with address byte
-                crc ^= byte;
-                for (int k = 0; k < 8; k++) {
-                    if (crc & 1)
-                        crc = (crc >> 1) ^ CRC32_IEEE_POLYNOM;
-                    else
-                        crc >>= 1;
+
+            // collect address (in machine byte order) and data in buffer, and update CRC32 in large steps
+            uint8_t buf[64 * (sizeof(MEMIMAGE_ADDR_T) + 1)];
+            size_t  len = 0;
+            for (size_t i = offsetStart; i <= offsetEnd; i++) {
+                MEMIMAGE_ADDR_T address = segment->address + i;
+                memcpy(buf + len, &address, sizeof(MEMIMAGE_ADDR_T));
+                buf[len + sizeof(MEMIMAGE_ADDR_T)] = segment->data[i];
+                len += sizeof(MEMIMAGE_ADDR_T) + 1;
+                if ((len == sizeof(buf)) || (i == offsetEnd)) {
+                    crc = crc32_update(crc, buf, len);
+                    len = 0;
                 }
+            }
 
-            } // loop over address bytes
+        // update CRC32 with contiguous data
+        #else
 
-        #endif // MEMIMAGE_CHK_INCLUDE_ADDRESS
+            crc = crc32_update(crc, segment->data + offsetStart, offsetEnd - offsetStart + 1);
 
-        // update CRC32 with data. Only 1B -> no need to check endianness
-        crc ^= image->memoryEntries[i].data;
-        for (int j = 0; j < 8*sizeof(uint8_t); j++) {
-            if (crc & 1)
-                crc = (crc >> 1) ^ CRC32_IEEE_POLYNOM;
-            else
-                crc >>= 1;
-        }
+        #endif // MEMIMAGE_CHK_INCLUDE_ADDRESS
 
-    } // loop over memory range
+    } // loop over segments
 
     // finalize CRC32 checksum
     crc ^= 0xffffffff;
@@ -418,9 +993,14 @@ bool MemoryImage_fillValue(MemoryImage_s* image, const MEMIMAGE_ADDR_T addrStart
         }
     #endif // MEMIMAGE_DEBUG
 
-    // loop over address range and add/replace fixed data
-    for (MEMIMAGE_ADDR_T address = addrStart; address <= addrEnd; address++) {
-        result &= MemoryImage_addData(image, address, value);
+    // add/replace fixed data in chunks
+    uint8_t buf[MEMIMAGE_CHUNK_SIZE];
+    memset(buf, value, sizeof(buf));
+    for (MEMIMAGE_ADDR_T address = addrStart; address <= addrEnd; address += sizeof(buf)) {
+        size_t len = (size_t) MIN(addrEnd - address, sizeof(buf) - 1) + 1;
+        result &= MemoryImage_addBlock(image, address, buf, len);
+        if (addrEnd - address < sizeof(buf))
+            break;
     }
 
     // return cumulated result
@@ -433,7 +1013,7 @@ bool MemoryImage_fillRandom(MemoryImage_s* image, const MEMIMAGE_ADDR_T addrStar
 
     bool result = true;
     static bool flagOnce = true;
-    
+
     // optional debug output
     #if defined(MEMIMAGE_DEBUG)
         if (image->debug >= 1) {
@@ -454,9 +1034,16 @@ bool MemoryImage_fillRandom(MemoryImage_s* image, const MEMIMAGE_ADDR_T addrStar
         srand(seed);
     }
 
-    // loop over address range and add/replace random data
-    for (MEMIMAGE_ADDR_T address = addrStart; address <= addrEnd; address++) {
-        result &= MemoryImage_addData(image, address, rand() % 0xFF);
+    // add/replace random data in chunks
+    uint8_t buf[MEMIMAGE_CHUNK_SIZE];
+    for (MEMIMAGE_ADDR_T address = addrStart; address <= addrEnd; address += sizeof(buf)) {
+        size_t len = (size_t) MIN(addrEnd - address, sizeof(buf) - 1) + 1;
+        for (size_t i = 0; i < len; i++) {
+            buf[i] = rand() % 0xFF;
+        }
+        result &= MemoryImage_addBlock(image, address, buf, len);
+        if (addrEnd - address < sizeof(buf))
+            break;
     }
 
     // return cumulated result
@@ -476,15 +1063,18 @@ bool MemoryImage_clip(MemoryImage_s* image, const MEMIMAGE_ADDR_T addrStart, con
         }
     #endif // MEMIMAGE_DEBUG
 
-    // loop over image and remove data outside [addrStart;addrEnd]
-    size_t i = 0;
-    while (i != image->numEntries) {
-        MEMIMAGE_ADDR_T address = image->memoryEntries[i].address;
-        if ((address < addrStart) || (address > addrEnd)) {
-            result &= MemoryImage_deleteData(image, address);
-        } else {
-            i++;
-        }
+    // empty image -> nothing to do
+    if (MemoryImage_isEmpty(image))
+        return true;
+
+    // remove data below addrStart
+    if (MemoryImage_getFirstAddress(image) < addrStart) {
+        result &= MemoryImage_deleteRange(image, MemoryImage_getFirstAddress(image), addrStart-1);
+    }
+
+    // remove data above addrEnd
+    if ((!MemoryImage_isEmpty(image)) && (MemoryImage_getLastAddress(image) > addrEnd)) {
+        result &= MemoryImage_deleteRange(image, addrEnd+1, MemoryImage_getLastAddress(image));
     }
 
     // return cumulated result
@@ -504,18 +1094,10 @@ bool MemoryImage_cut(MemoryImage_s* image, const MEMIMAGE_ADDR_T addrStart, cons
         }
     #endif // MEMIMAGE_DEBUG
 
-    // loop over image and remove data inside [addrStart;addrEnd]
-    size_t i = 0;
-    while (i != image->numEntries) {
-        MEMIMAGE_ADDR_T address = image->memoryEntries[i].address;
-        if ((address >= addrStart) && (address <= addrEnd)) {
-            result &= MemoryImage_deleteData(image, address);
-        } else {
-            i++;
-        }
-    }
+    // remove data inside [addrStart;addrEnd]
+    result = MemoryImage_deleteRange(image, addrStart, addrEnd);
 
-    // return cumulated result
+    // return result
     return result;
 
 } // MemoryImage_cut()
@@ -531,22 +1113,35 @@ bool MemoryImage_clone(const MemoryImage_s* srcImage, MemoryImage_s* destImage)
     #endif // MEMIMAGE_DEBUG
 
     // assert empty destination
-    if (destImage->memoryEntries != NULL) {
+    if (destImage->segments != NULL) {
         MemoryImage_free(destImage);
     } else {
         MemoryImage_init(destImage);
     }
-    
-    // allocate memory and copy srcImage data to destImage. Copy only used buffer
-    size_t size = srcImage->numEntries * sizeof(MemoryEntry_s);
-    destImage->memoryEntries = (MemoryEntry_s*) malloc(size);
-    if (destImage->memoryEntries == NULL) {
-        fprintf(stderr, "Error in cloneMemoryImage(): failed to allocate %ldB\n", (long) size);
+
+    // allocate segment list. Copy only used segments
+    if (!MemoryImage_reserveSegments(destImage, srcImage->numSegments)) {
+        fprintf(stderr, "Error in MemoryImage_clone(): failed to allocate %ld segments\n", (long) srcImage->numSegments);
         return false;
     }
-    memcpy((void*) destImage->memoryEntries, (void*) srcImage->memoryEntries, size);
+
+    // copy srcImage segments to destImage. Copy only used data
+    for (size_t i = 0; i < srcImage->numSegments; i++) {
+        const MemorySegment_s* srcSegment = &(srcImage->segments[i]);
+        MemorySegment_s* destSegment = &(destImage->segments[i]);
+        destSegment->address  = srcSegment->address;
+        destSegment->data     = (uint8_t*) malloc(srcSegment->numBytes);
+        if (destSegment->data == NULL) {
+            fprintf(stderr, "Error in MemoryImage_clone(): failed to allocate %ldB\n", (long) srcSegment->numBytes);
+            MemoryImage_free(destImage);
+            return false;
+        }
+        memcpy(destSegment->data, srcSegment->data, srcSegment->numBytes);
+        destSegment->numBytes = srcSegment->numBytes;
+        destSegment->capacity = srcSegment->numBytes;
+        destImage->numSegments++;
+    }
     destImage->numEntries = srcImage->numEntries;
-    destImage->capacity = srcImage->numEntries;
     #if defined(MEMIMAGE_DEBUG)
         destImage->debug = srcImage->debug;
     #endif // MEMIMAGE_DEBUG
@@ -559,8 +1154,6 @@ bool MemoryImage_clone(const MemoryImage_s* srcImage, MemoryImage_s* destImage)
 
 bool MemoryImage_merge(const MemoryImage_s* srcImage, MemoryImage_s* destImage) {
 
-    bool result = true;
-
     // optional debug output
     #if defined(MEMIMAGE_DEBUG)
         if ((srcImage->debug >= 1) || (destImage->debug >= 1)) {
@@ -568,15 +1161,116 @@ bool MemoryImage_merge(const MemoryImage_s* srcImage, MemoryImage_s* destImage)
         }
     #endif // MEMIMAGE_DEBUG
 
-    // loop over srcImage and add/replace data to/in destImage
-    for (size_t i=0; i < srcImage->numEntries; i++) {
-        result &= MemoryImage_addData(destImage, srcImage->memoryEntries[i].address, srcImage->memoryEntries[i].data);
+    // merge both images in single pass. Data in srcImage has priority
+    const MemoryImage_s* images[2] = { destImage, srcImage };
+    return MemoryImage_mergeImages(images, 2, destImage);
+
+} // MemoryImage_merge()
+
+
+bool MemoryImage_mergeImages(const MemoryImage_s* const srcImages[], const size_t numImages, MemoryImage_s* destImage) {
+
+    // optional debug output
+    #if defined(MEMIMAGE_DEBUG)
+        if (destImage->debug >= 1) {
+            fprintf(stderr, "MemoryImage_mergeImages(): %d images\n", (int) numImages);
+        }
+    #endif // MEMIMAGE_DEBUG
+
+    // merge into temporary image, as destImage may also be a source
+    MemoryImage_s tmpImage;
+    MemoryImage_init(&tmpImage);
+    #if defined(MEMIMAGE_DEBUG)
+        tmpImage.debug = destImage->debug;
+    #endif // MEMIMAGE_DEBUG
+
+    // current segment of each source image
+    size_t *cursor = (size_t*) calloc(numImages+1, sizeof(size_t));
+    if (cursor == NULL) {
+        fprintf(stderr, "Error in MemoryImage_mergeImages(): failed to allocate %d cursors\n", (int) numImages);
+        return false;
     }
 
-    // return cumulated result
-    return result;
+    // 1st pass: sweep over segments of all images in address order and build union of segments
+    while (true) {
+
+        // find source segment with lowest start address
+        const MemorySegment_s* next = NULL;
+        size_t idxImage = 0;
+        for (size_t i = 0; i < numImages; i++) {
+            if (cursor[i] < srcImages[i]->numSegments) {
+                const MemorySegment_s* segment = &(srcImages[i]->segments[cursor[i]]);
+                if ((next == NULL) || (segment->address < next->address)) {
+                    next = segment;
+                    idxImage = i;
+                }
+            }
+        }
+        if (next == NULL)
+            break;
+        cursor[idxImage]++;
+
+        // overlaps or touches last merged segment -> extend merged segment
+        if (tmpImage.numSegments > 0) {
+            MemorySegment_s* last = &(tmpImage.segments[tmpImage.numSegments-1]);
+            if (next->address - last->address <= last->numBytes) {
+                size_t numBytes = next->address - last->address + next->numBytes;
+                if (numBytes > last->numBytes)
+                    last->numBytes = numBytes;
+                continue;
+            }
+        }
 
-} // MemoryImage_merge()
+        // else start new merged segment
+        if (!MemoryImage_insertSegment(&tmpImage, tmpImage.numSegments, next->address)) {
+            free(cursor);
+            MemoryImage_free(&tmpImage);
+            return false;
+        }
+        tmpImage.segments[tmpImage.numSegments-1].numBytes = next->numBytes;
+
+    } // 1st pass
+    free(cursor);
+
+    // check size limit
+    for (size_t i = 0; i < tmpImage.numSegments; i++) {
+        tmpImage.numEntries += tmpImage.segments[i].numBytes;
+    }
+    if (tmpImage.numEntries > MEMIMAGE_BUFFER_MAX) {
+        fprintf(stderr, "Error in MemoryImage_mergeImages(): buffer size limit of %gMB reached\n", (float) MEMIMAGE_BUFFER_MAX/(1024.0*1024.0));
+        MemoryImage_free(&tmpImage);
+        return false;
+    }
+
+    // allocate data buffers of merged segments with exact size
+    for (size_t i = 0; i < tmpImage.numSegments; i++) {
+        if (!MemorySegment_reserve(&(tmpImage.segments[i]), tmpImage.segments[i].numBytes)) {
+            MemoryImage_free(&tmpImage);
+            return false;
+        }
+    }
+
+    // 2nd pass: copy source data to merged segments in priority order, i.e. later images overwrite earlier ones
+    for (size_t i = 0; i < numImages; i++) {
+        size_t idxMerged = 0;
+        for (size_t j = 0; j < srcImages[i]->numSegments; j++) {
+            const MemorySegment_s* segment = &(srcImages[i]->segments[j]);
+            MemorySegment_s* merged = &(tmpImage.segments[idxMerged]);
+            while (segment->address - merged->address >= merged->numBytes) {
+                merged = &(tmpImage.segments[++idxMerged]);
+            }
+            memcpy(merged->data + (segment->address - merged->address), segment->data, segment->numBytes);
+        }
+    }
+
+    // copy result to destImage. Release original buffers
+    MemoryImage_free(destImage);
+    *destImage = tmpImage;
+
+    // return success
+    return true;
+
+} // MemoryImage_mergeImages()
 
 
 bool MemoryImage_copyRange(MemoryImage_s* image, const MEMIMAGE_ADDR_T addrFromStart, const MEMIMAGE_ADDR_T addrFromEnd, const MEMIMAGE_ADDR_T addrToStart) {
@@ -590,24 +1284,19 @@ bool MemoryImage_copyRange(MemoryImage_s* image, const MEMIMAGE_ADDR_T addrFromS
         }
     #endif // MEMIMAGE_DEBUG
 
-    // copy image to temporary working image
-    MemoryImage_s tmpImage;
-    MemoryImage_init(&tmpImage);
-    result &= MemoryImage_clone(image, &tmpImage);
+    // extract range to temporary image with shifted addresses
+    MemoryImage_s rangeImage;
+    MemoryImage_init(&rangeImage);
+    result &= MemoryImage_extractRange(image, addrFromStart, addrFromEnd, addrToStart, &rangeImage);
 
-    // loop over image and copy specified range to temporary image
-    for (size_t i=0; i < image->numEntries; i++) {
-        MEMIMAGE_ADDR_T address = image->memoryEntries[i].address;
-        if ((address >= addrFromStart) && (address <= addrFromEnd)) {
-            result &= MemoryImage_addData(&tmpImage, address-addrFromStart+addrToStart, image->memoryEntries[i].data);
-        }
+    // splice shifted data back into image
+    for (size_t i=0; i < rangeImage.numSegments; i++) {
+        const MemorySegment_s* segment = &(rangeImage.segments[i]);
+        result &= MemoryImage_addBlock(image, segment->address, segment->data, segment->numBytes);
     }
 
-    // copy result to image. Release original buffer
-    free(image->memoryEntries);
-    image->memoryEntries = tmpImage.memoryEntries;
-    image->numEntries = tmpImage.numEntries;
-    image->capacity = tmpImage.capacity;
+    // release temporary image
+    MemoryImage_free(&rangeImage);
 
     // return cumulated result
     return result;
@@ -626,36 +1315,133 @@ bool MemoryImage_moveRange(MemoryImage_s* image, const MEMIMAGE_ADDR_T addrFromS
         }
     #endif // MEMIMAGE_DEBUG
 
-    // copy image to temporary working image
-    MemoryImage_s tmpImage;
-    MemoryImage_init(&tmpImage);
-    result &= MemoryImage_clone(image, &tmpImage);
+    // extract range to temporary image with shifted addresses
+    MemoryImage_s rangeImage;
+    MemoryImage_init(&rangeImage);
+    result &= MemoryImage_extractRange(image, addrFromStart, addrFromEnd, addrToStart, &rangeImage);
+
+    // remove range from image
+    result &= MemoryImage_deleteRange(image, addrFromStart, addrFromEnd);
+
+    // splice shifted data back into image
+    for (size_t i=0; i < rangeImage.numSegments; i++) {
+        const MemorySegment_s* segment = &(rangeImage.segments[i]);
+        result &= MemoryImage_addBlock(image, segment->address, segment->data, segment->numBytes);
+    }
+
+    // release temporary image
+    MemoryImage_free(&rangeImage);
+
+    // return cumulated result
+    return result;
+
+} // MemoryImage_moveRange()
+
+
+void MemoryStaging_init(MemoryStaging_s* staging) {
+
+    // initialize struct variables
+    staging->entries = NULL;
+    staging->numEntries = 0;
+    staging->capacity = 0;
+
+} // MemoryStaging_init()
+
+
+void MemoryStaging_free(MemoryStaging_s* staging) {
+
+    // release buffer and reset struct variables
+    free(staging->entries);
+    MemoryStaging_init(staging);
+
+} // MemoryStaging_free()
+
+
+bool MemoryStaging_addData(MemoryStaging_s* staging, const MEMIMAGE_ADDR_T address, const uint8_t data) {
+
+    // expand buffer, if required
+    if (staging->numEntries+1 > staging->capacity) {
+
+        // assert buffer size limit [B], each entry holds address and data
+        const size_t maxEntries = (MEMIMAGE_BUFFER_MAX) / sizeof(MemoryEntry_s);
+        if (staging->numEntries+1 > maxEntries) {
+            fprintf(stderr, "Error in MemoryStaging_addData(): buffer size limit of %gMB reached\n", (float) MEMIMAGE_BUFFER_MAX/(1024.0*1024.0));
+            return false;
+        }
 
-    // loop over image and remove specified range from temporary image
-    for (size_t i=0; i < image->numEntries; i++) {
-        MEMIMAGE_ADDR_T address = image->memoryEntries[i].address;
-        if ((address >= addrFromStart) && (address <= addrFromEnd)) {
-            result &= MemoryImage_deleteData(&tmpImage, address);
+        // re-allocate buffer. Return on fail
+        size_t newCapacity = MAX(staging->numEntries+1, MIN(ceil((float) staging->capacity * (float) MEMIMAGE_BUFFER_MARGIN), maxEntries));
+        MemoryEntry_s* entries = (MemoryEntry_s*) realloc(staging->entries, newCapacity * sizeof(MemoryEntry_s));
+        if (entries == NULL) {
+            fprintf(stderr, "Error in MemoryStaging_addData(): failed to reallocate %ldB\n", (long) (newCapacity * sizeof(MemoryEntry_s)));
+            return false;
         }
+        staging->entries = entries;
+        staging->capacity = newCapacity;
     }
-    
-    // loop over image and add specified range to temporary image
-    for (size_t i=0; i < image->numEntries; i++) {
-        MEMIMAGE_ADDR_T address = image->memoryEntries[i].address;
-        if ((address >= addrFromStart) && (address <= addrFromEnd)) {
-            result &= MemoryImage_addData(&tmpImage, address-addrFromStart+addrToStart, image->memoryEntries[i].data);
+
+    // append entry
+    staging->entries[staging->numEntries].address = address;
+    staging->entries[staging->numEntries].data = data;
+    staging->numEntries++;
+
+    // return success
+    return true;
+
+} // MemoryStaging_addData()
+
+
+bool MemoryStaging_commit(MemoryStaging_s* staging, MemoryImage_s* image) {
+
+    bool            result = true;
+    uint8_t         buf[MEMIMAGE_CHUNK_SIZE];
+    size_t          len = 0;
+    MEMIMAGE_ADDR_T addrBlock = 0;
+
+    // optional debug output
+    #if defined(MEMIMAGE_DEBUG)
+        if (image->debug >= 1) {
+            fprintf(stderr, "MemoryStaging_commit(): %ld entries\n", (long) staging->numEntries);
         }
+    #endif // MEMIMAGE_DEBUG
+
+    // sort entries by address
+    if (!MemoryStaging_sort(staging)) {
+        MemoryStaging_free(staging);
+        return false;
     }
 
-    // copy result to image. Release original buffer
-    free(image->memoryEntries);
-    image->memoryEntries = tmpImage.memoryEntries;
-    image->numEntries = tmpImage.numEntries;
-    image->capacity = tmpImage.capacity;
+    // loop over sorted entries and add consecutive data as blocks
+    for (size_t i = 0; i < staging->numEntries; i++) {
+        const MemoryEntry_s* entry = &(staging->entries[i]);
+
+        // skip entry if overwritten by later entry with same address
+        if ((i+1 < staging->numEntries) && (staging->entries[i+1].address == entry->address))
+            continue;
+
+        // store block on gap or full buffer
+        if ((len > 0) && ((entry->address != addrBlock + len) || (len == sizeof(buf)))) {
+            result &= MemoryImage_addBlock(image, addrBlock, buf, len);
+            len = 0;
+        }
+
+        // add data to current block
+        if (len == 0)
+            addrBlock = entry->address;
+        buf[len++] = entry->data;
+
+    } // loop over entries
+
+    // store last block
+    if (len > 0)
+        result &= MemoryImage_addBlock(image, addrBlock, buf, len);
+
+    // clear staging buffer
+    MemoryStaging_free(staging);
 
     // return cumulated result
     return result;
 
-} // MemoryImage_moveRange()
+} // MemoryStaging_commit()
 
 // end of file
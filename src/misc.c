@@ -13,6 +13,7 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <sys/time.h>
+#include <pthread.h>
 
 #include "misc.h"
 #include "main.h"
@@ -562,4 +563,194 @@ bool isLittleEndian(void) {
   
 } // isLittleEndian()
 
+
+
+/**
+  \fn const char* getExtension(const char *filename, char *ext, const size_t maxLen)
+
+  \param[in]  filename   name of file, optionally with path
+  \param[out] ext        extension including '.', e.g. ".s19"
+  \param[in]  maxLen     size of ext buffer
+
+  \return pointer to ext, or NULL if file name has no extension
+
+  Get extension of file name. A compression suffix (.gz, .xz) is skipped,
+  i.e. for "data.s19.gz" the extension is ".s19"
+*/
+const char* getExtension(const char *filename, char *ext, const size_t maxLen) {
+
+  // skip path
+  const char *name = filename;
+  for (const char *p = filename; *p != '\0'; p++) {
+    if ((*p == '/') || (*p == '\\'))
+      name = p + 1;
+  }
+
+  // get last extension
+  size_t len = strlen(name);
+  const char *dot = strrchr(name, '.');
+  if (dot == NULL)
+    return NULL;
+
+  // skip compression suffix and get previous extension
+  if ((!strcmp(dot, ".gz")) || (!strcmp(dot, ".GZ")) || (!strcmp(dot, ".xz")) || (!strcmp(dot, ".XZ"))) {
+    len = (size_t) (dot - name);
+    dot = NULL;
+    for (size_t i = 0; i < len; i++) {
+      if (name[i] == '.')
+        dot = name + i;
+    }
+    if (dot == NULL)
+      return NULL;
+  }
+
+  // copy extension
+  len = (size_t) (name + len - dot);
+  if (len > maxLen - 1)
+    len = maxLen - 1;
+  strncpy(ext, dot, len);
+  ext[len] = '\0';
+
+  return ext;
+
+} // getExtension()
+
+
+
+/**
+  \fn FILE* redirectStdout(void)
+
+  \return stream to original stdout, or stdout on failure
+
+  Redirect stdout to stderr, e.g. to keep console messages out of data exported to stdout.
+  Data is written to the returned stream, which refers to the original stdout
+*/
+FILE* redirectStdout(void) {
+
+  // duplicate stdout
+  fflush(stdout);
+  int fd = dup(fileno(stdout));
+  if (fd < 0)
+    return stdout;
+  FILE *fp = fdopen(fd, "wb");
+  if (fp == NULL) {
+    close(fd);
+    return stdout;
+  }
+
+  // print console output to stderr
+  if (dup2(fileno(stderr), fileno(stdout)) < 0) {
+    fclose(fp);
+    return stdout;
+  }
+
+  return fp;
+
+} // redirectStdout()
+
+
+
+/**
+  \fn int getNumCores(void)
+
+  \return number of available CPU cores (min. 1)
+
+  Get number of available CPU cores, e.g. for number of worker threads
+*/
+int getNumCores(void) {
+
+  #if defined(WIN32) || defined(WIN64)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int num = (int) info.dwNumberOfProcessors;
+  #else
+    int num = (int) sysconf(_SC_NPROCESSORS_ONLN);
+  #endif
+
+  return (num > 0) ? num : 1;
+
+} // getNumCores()
+
+
+
+/**
+  \fn void runParallel(void* (*func)(void*), void *tasks, const size_t sizeTask, const int numTasks)
+
+  \param[in] func       function to execute for each task
+  \param     tasks      array of task parameters, passed to func
+  \param[in] sizeTask   size of single task parameter [B]
+  \param[in] numTasks   number of tasks
+
+  Execute func for all tasks in separate threads and wait until all are finished.
+  If a thread cannot be created, the respective task is executed in the calling thread.
+*/
+void runParallel(void* (*func)(void*), void *tasks, const size_t sizeTask, const int numTasks) {
+
+  pthread_t   *threads = (pthread_t*) malloc(numTasks * sizeof(pthread_t));
+  bool        *started = (bool*) calloc(numTasks, sizeof(bool));
+
+  // start threads. Last task and tasks w/o thread are executed in calling thread
+  for (int i = 0; i < numTasks; i++) {
+    void *task = (uint8_t*) tasks + i*sizeTask;
+    if ((threads != NULL) && (started != NULL) && (i < numTasks-1) && (pthread_create(&(threads[i]), NULL, func, task) == 0))
+      started[i] = true;
+    else
+      func(task);
+  }
+
+  // wait for threads to finish
+  for (int i = 0; i < numTasks; i++) {
+    if ((started != NULL) && (started[i]))
+      pthread_join(threads[i], NULL);
+  }
+
+  // release buffers
+  free(threads);
+  free(started);
+
+} // runParallel()
+
+
+
+/**
+  \fn bool cpuHas(const cpuFeature_t feature)
+
+  \param[in] feature    CPU feature to check
+
+  \return feature is supported by CPU. Always false for non-x86 or non-GCC builds
+
+  Check CPU feature for selecting SIMD kernels at runtime. Features are detected on the
+  first call and cached. Concurrent first calls, e.g. from import or checksum threads,
+  detect the same features, so relaxed atomic access to the cache is sufficient.
+*/
+bool cpuHas(const cpuFeature_t feature) {
+
+  #if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+
+    // bitmask of supported features, bit 31 marks 'detected'
+    static uint32_t features = 0;
+
+    uint32_t mask = __atomic_load_n(&features, __ATOMIC_RELAXED);
+    if (mask == 0) {
+      __builtin_cpu_init();
+      mask = (uint32_t) 1 << 31;
+      if (__builtin_cpu_supports("sse2"))   mask |= (uint32_t) 1 << CPU_SSE2;
+      if (__builtin_cpu_supports("sse4.1")) mask |= (uint32_t) 1 << CPU_SSE41;
+      if (__builtin_cpu_supports("sse4.2")) mask |= (uint32_t) 1 << CPU_SSE42;
+      if (__builtin_cpu_supports("avx2"))   mask |= (uint32_t) 1 << CPU_AVX2;
+      if (__builtin_cpu_supports("pclmul")) mask |= (uint32_t) 1 << CPU_PCLMUL;
+      if (__builtin_cpu_supports("sha"))    mask |= (uint32_t) 1 << CPU_SHA;
+      __atomic_store_n(&features, mask, __ATOMIC_RELAXED);
+    }
+    return (mask >> feature) & 1;
+
+  #else
+
+    (void) feature;
+    return false;
+
+  #endif
+
+} // cpuHas()
+
 // end of file
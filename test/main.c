@@ -1,4 +1,31 @@
 #include <unity.h>
+#include <string.h>
+#include "main.h"
+#include "memory_image.h"
+#include "hexfile.h"
+#include "crc32.h"
+#include "checksum.h"
+#include "hexdecode.h"
+
+// build with -DCRC32_NO_SIMD -DCHECKSUM_NO_SIMD -DHEXDECODE_NO_SIMD (env:linux_x86_64_nosimd) to test portable code
+
+/// max. length of test data [B]
+#define TEST_DATA_SIZE      1024
+
+/// pseudo-random test data
+static uint8_t testData[TEST_DATA_SIZE];
+
+/// address range of reference model for memory image tests
+#define REF_SIZE            4096
+
+/// reference model of memory image, i.e. plain byte array with flags for used addresses
+typedef struct {
+    uint8_t     data[REF_SIZE];     //< data at address
+    bool        used[REF_SIZE];     //< address contains data
+} RefImage_s;
+
+/// scratch file for export tests
+#define TEST_FILE           "test_export.tmp"
 
 void setUp(void) {
     // set stuff up here
@@ -8,7 +35,749 @@ void tearDown(void) {
     // clean stuff up here
 }
 
+
+/// @brief fill buffer with reproducible pseudo-random data
+static void fill_random(uint8_t* buf, const size_t len, uint32_t seed) {
+    for (size_t i = 0; i < len; i++) {
+        seed = seed * 1103515245 + 12345;
+        buf[i] = (uint8_t) (seed >> 16);
+    }
+}
+
+/// @brief next pseudo-random number in [0;range)
+static uint32_t random_next(uint32_t* seed, const uint32_t range) {
+    *seed = *seed * 1103515245 + 12345;
+    return (*seed >> 8) % range;
+}
+
+/// @brief store data in reference model
+static void ref_add(RefImage_s* ref, const size_t address, const uint8_t* buf, const size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        ref->data[address+i] = buf[i];
+        ref->used[address+i] = true;
+    }
+}
+
+/// @brief remove data in [addrStart;addrEnd] from reference model
+static void ref_delete(RefImage_s* ref, const size_t addrStart, const size_t addrEnd) {
+    for (size_t addr = addrStart; (addr <= addrEnd) && (addr < REF_SIZE); addr++)
+        ref->used[addr] = false;
+}
+
+/// @brief copy or move used data in [addrStart;addrEnd] to addrTo in reference model, via snapshot like memmove
+static void ref_copy(RefImage_s* ref, const size_t addrStart, const size_t addrEnd, const size_t addrTo, const bool move) {
+    RefImage_s tmp = *ref;
+    if (move)
+        ref_delete(ref, addrStart, addrEnd);
+    for (size_t addr = addrStart; addr <= addrEnd; addr++) {
+        if (tmp.used[addr])
+            ref_add(ref, addr - addrStart + addrTo, &(tmp.data[addr]), 1);
+    }
+}
+
+/// @brief assert that memory image matches reference model and that segments are sorted, neither overlap nor touch
+static void check_image(const MemoryImage_s* image, const RefImage_s* ref) {
+    size_t numUsed = 0, numBytes = 0;
+    for (size_t addr = 0; addr < REF_SIZE; addr++)
+        numUsed += ref->used[addr];
+    for (size_t i = 0; i < image->numSegments; i++) {
+        const MemorySegment_s* segment = &(image->segments[i]);
+        TEST_ASSERT_TRUE(segment->numBytes > 0);
+        TEST_ASSERT_TRUE(segment->address + segment->numBytes <= REF_SIZE);
+        if (i > 0)
+            TEST_ASSERT_TRUE(segment->address > image->segments[i-1].address + image->segments[i-1].numBytes);
+        for (size_t j = 0; j < segment->numBytes; j++) {
+            TEST_ASSERT_TRUE(ref->used[segment->address + j]);
+            TEST_ASSERT_EQUAL_HEX8(ref->data[segment->address + j], segment->data[j]);
+        }
+        numBytes += segment->numBytes;
+    }
+    TEST_ASSERT_EQUAL(numUsed, numBytes);
+    TEST_ASSERT_EQUAL(numUsed, image->numEntries);
+}
+
+/// @brief assert that two memory images contain identical segments
+static void compare_images(const MemoryImage_s* image1, const MemoryImage_s* image2) {
+    TEST_ASSERT_EQUAL(image1->numEntries, image2->numEntries);
+    TEST_ASSERT_EQUAL(image1->numSegments, image2->numSegments);
+    for (size_t i = 0; i < image1->numSegments; i++) {
+        TEST_ASSERT_EQUAL_HEX64(image1->segments[i].address, image2->segments[i].address);
+        TEST_ASSERT_EQUAL(image1->segments[i].numBytes, image2->segments[i].numBytes);
+        TEST_ASSERT_EQUAL_MEMORY(image1->segments[i].data, image2->segments[i].data, image1->segments[i].numBytes);
+    }
+}
+
+/// @brief fill memory image and reference model with random blocks
+static void fill_random_blocks(MemoryImage_s* image, RefImage_s* ref, const int numBlocks, uint32_t* seed) {
+    for (int i = 0; i < numBlocks; i++) {
+        size_t addr = random_next(seed, REF_SIZE);
+        size_t len  = 1 + random_next(seed, 200);
+        size_t ofs  = random_next(seed, TEST_DATA_SIZE - 200);
+        if (addr + len > REF_SIZE)
+            len = REF_SIZE - addr;
+        TEST_ASSERT_TRUE(MemoryImage_addBlock(image, addr, testData + ofs, len));
+        ref_add(ref, addr, testData + ofs, len);
+    }
+}
+
+/// @brief bitwise CRC32-IEEE reference
+static uint32_t crc32_bitwise(const uint8_t* data, const size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++)
+            crc = (crc >> 1) ^ ((crc & 1) ? CRC32_IEEE_POLYNOM : 0);
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+/// @brief CRC32-IEEE via crc32_update() incl. initial value and final XOR
+static uint32_t crc32_calc(const uint8_t* data, const size_t len) {
+    return crc32_update(0xFFFFFFFF, data, len) ^ 0xFFFFFFFF;
+}
+
+/// @brief scalar hex decoder reference. Returns false for invalid characters
+static bool hex_decode_ref(uint8_t* data, const char* str, const size_t len, uint8_t* sum) {
+    for (size_t i = 0; i < 2*len; i++) {
+        char c = str[i];
+        int  digit = ((c >= '0') && (c <= '9')) ? c - '0' : ((c >= 'a') && (c <= 'f')) ? c - 'a' + 10 : ((c >= 'A') && (c <= 'F')) ? c - 'A' + 10 : -1;
+        if (digit < 0)
+            return false;
+        data[i/2] = (i & 1) ? (uint8_t) ((data[i/2] << 4) | digit) : (uint8_t) digit;
+    }
+    for (size_t i = 0; i < len; i++)
+        *sum += data[i];
+    return true;
+}
+
+/// @brief checksum of data in single step
+static void checksum_calc(const checksum_t algo, const void* data, const size_t len, uint8_t* digest) {
+    Checksum_s chk;
+    memset(digest, 0, CHECKSUM_MAX_SIZE);
+    Checksum_init(&chk, algo);
+    Checksum_update(&chk, data, len);
+    Checksum_final(&chk, digest);
+}
+
+
+/// CRC32 of all lengths and alignments matches bitwise reference
+void test_crc32_update(void) {
+    const size_t align[] = { 0, 1, 3, 7, 8, 13 };
+    for (size_t a = 0; a < sizeof(align)/sizeof(align[0]); a++) {
+        for (size_t len = 0; len <= 300; len++)
+            TEST_ASSERT_EQUAL_HEX32(crc32_bitwise(testData + align[a], len), crc32_calc(testData + align[a], len));
+    }
+}
+
+/// CRC32 updated in pieces matches single update
+void test_crc32_update_split(void) {
+    const size_t len = 777;
+    for (size_t split = 0; split <= len; split += 37) {
+        uint32_t crc = crc32_update(0xFFFFFFFF, testData, split);
+        crc = crc32_update(crc, testData + split, len - split) ^ 0xFFFFFFFF;
+        TEST_ASSERT_EQUAL_HEX32(crc32_bitwise(testData, len), crc);
+    }
+}
+
+/// joined CRC32 of two blocks matches CRC32 of concatenated data
+void test_crc32_join(void) {
+    const size_t len[] = { 0, 1, 2, 15, 64, 100, 257, 500 };
+    for (size_t i = 0; i < sizeof(len)/sizeof(len[0]); i++) {
+        for (size_t j = 0; j < sizeof(len)/sizeof(len[0]); j++) {
+            uint32_t crc1 = crc32_calc(testData, len[i]);
+            uint32_t crc2 = crc32_calc(testData + len[i], len[j]);
+            TEST_ASSERT_EQUAL_HEX32(crc32_calc(testData, len[i] + len[j]), crc32_join(crc1, crc2, len[j]));
+        }
+    }
+}
+
+/// block checksums of image are independent of number of threads, also for chunked blocks
+void test_checksum_image_threads(void) {
+
+    MemoryImage_s   image;
+    const size_t    lenLarge = 3*1024*1024 + 12345;
+    uint8_t         *large = (uint8_t*) malloc(lenLarge);
+    const int       threads[] = { 1, 3, 16 };
+    uint32_t        chkRef[3], chk[3];
+
+    // image with large block (split into chunks), small block and single byte
+    TEST_ASSERT_NOT_NULL(large);
+    fill_random(large, lenLarge, 42);
+    MemoryImage_init(&image);
+    TEST_ASSERT_TRUE(MemoryImage_addBlock(&image, 0x1000, large, lenLarge));
+    TEST_ASSERT_TRUE(MemoryImage_addBlock(&image, 0x10000000, testData, 100));
+    TEST_ASSERT_TRUE(MemoryImage_addBlock(&image, 0x20000000, testData, 1));
+    TEST_ASSERT_EQUAL(3, image.numSegments);
+
+    // reference per block and over image
+    for (size_t i = 0; i < 3; i++) {
+        MEMIMAGE_ADDR_T addrStart = image.segments[i].address;
+        chkRef[i] = MemoryImage_checksum_crc32(&image, addrStart, addrStart + image.segments[i].numBytes - 1);
+    }
+    TEST_ASSERT_EQUAL_HEX32(crc32_bitwise(large, lenLarge), chkRef[0]);
+    uint32_t chkImage = MemoryImage_checksum_crc32(&image, MemoryImage_getFirstAddress(&image), MemoryImage_getLastAddress(&image));
+
+    // same result for any number of threads
+    for (size_t t = 0; t < sizeof(threads)/sizeof(threads[0]); t++) {
+        memset(chk, 0, sizeof(chk));
+        TEST_ASSERT_EQUAL_HEX32(chkImage, checksum_image(&image, chk, threads[t]));
+        TEST_ASSERT_EQUAL_HEX32_ARRAY(chkRef, chk, 3);
+    }
+
+    MemoryImage_free(&image);
+    free(large);
+
+}
+
+/// check value of each algorithm for "123456789"
+void test_checksum_check_values(void) {
+
+    const char  *msg = "123456789";
+    const struct {
+        checksum_t  algo;
+        uint8_t     digest[CHECKSUM_MAX_SIZE];
+    } ref[] = {
+        { CHECKSUM_CRC32,       { 0xCB, 0xF4, 0x39, 0x26 } },
+        { CHECKSUM_CRC16_CCITT, { 0x29, 0xB1 } },
+        { CHECKSUM_CRC32C,      { 0xE3, 0x06, 0x92, 0x83 } },
+        { CHECKSUM_CRC32_MPEG2, { 0x03, 0x76, 0xE6, 0xE7 } },
+        { CHECKSUM_ADLER32,     { 0x09, 0x1E, 0x01, 0xDE } },
+        { CHECKSUM_SHA256,      { 0x15, 0xE2, 0xB0, 0xD3, 0xC3, 0x38, 0x91, 0xEB, 0xB0, 0xF1, 0xEF, 0x60, 0x9E, 0xC4, 0x19, 0x42,
+                                  0x0C, 0x20, 0xE3, 0x20, 0xCE, 0x94, 0xC6, 0x5F, 0xBC, 0x8C, 0x33, 0x12, 0x44, 0x8E, 0xB2, 0x25 } }
+    };
+    uint8_t digest[CHECKSUM_MAX_SIZE];
+
+    for (size_t i = 0; i < sizeof(ref)/sizeof(ref[0]); i++) {
+        checksum_calc(ref[i].algo, msg, strlen(msg), digest);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(ref[i].digest, digest, Checksum_getSize(ref[i].algo), Checksum_getName(ref[i].algo));
+    }
+
+}
+
+/// SHA-256 fed in odd chunk sizes matches single update
+void test_checksum_sha256_chunks(void) {
+
+    const size_t    sizes[] = { 1, 3, 7, 55, 56, 63, 64, 65, 127, 200 };
+    uint8_t         digestRef[CHECKSUM_MAX_SIZE], digest[CHECKSUM_MAX_SIZE];
+    Checksum_s      chk;
+
+    for (size_t len = 0; len <= TEST_DATA_SIZE; len += 111) {
+        checksum_calc(CHECKSUM_SHA256, testData, len, digestRef);
+        Checksum_init(&chk, CHECKSUM_SHA256);
+        for (size_t pos = 0, i = 0; pos < len; i++) {
+            size_t num = sizes[i % (sizeof(sizes)/sizeof(sizes[0]))];
+            if (num > len - pos)
+                num = len - pos;
+            Checksum_update(&chk, testData + pos, num);
+            pos += num;
+        }
+        Checksum_final(&chk, digest);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(digestRef, digest, CHECKSUM_MAX_SIZE);
+    }
+
+}
+
+/// constant data via Checksum_fill() matches streamed data, below and above shortcut threshold
+void test_checksum_fill(void) {
+
+    const uint64_t  len[] = { 0, 1, 100, CHECKSUM_FILL_MIN-1, CHECKSUM_FILL_MIN, CHECKSUM_FILL_MIN+1, 3*CHECKSUM_FILL_MIN+5 };
+    const uint8_t   value[] = { 0x00, 0xFF, 0x5A };
+    uint8_t         *buf = (uint8_t*) malloc(3*CHECKSUM_FILL_MIN+5);
+    uint8_t         digestRef[CHECKSUM_MAX_SIZE], digest[CHECKSUM_MAX_SIZE];
+    Checksum_s      chk;
+
+    TEST_ASSERT_NOT_NULL(buf);
+    for (checksum_t algo = CHECKSUM_CRC32; algo < CHECKSUM_UNKNOWN; algo++) {
+        for (size_t v = 0; v < sizeof(value); v++) {
+            for (size_t n = 0; n < sizeof(len)/sizeof(len[0]); n++) {
+
+                // data + constant bytes + data, streamed
+                memset(buf, value[v], len[n]);
+                Checksum_init(&chk, algo);
+                Checksum_update(&chk, testData, 10);
+                Checksum_update(&chk, buf, len[n]);
+                Checksum_update(&chk, testData + 10, 10);
+                Checksum_final(&chk, digestRef);
+
+                // same with constant bytes via fill
+                Checksum_init(&chk, algo);
+                Checksum_update(&chk, testData, 10);
+                Checksum_fill(&chk, value[v], len[n]);
+                Checksum_update(&chk, testData + 10, 10);
+                Checksum_final(&chk, digest);
+
+                TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(digestRef, digest, Checksum_getSize(algo), Checksum_getName(algo));
+            }
+        }
+    }
+    free(buf);
+
+}
+
+/// hex decoder matches scalar reference for all lengths, mixed case and single invalid characters
+void test_hex_decode(void) {
+
+    const char      digits[] = "0123456789abcdef0123456789ABCDEF";
+    const char      invalid[] = { 'g', 'G', 'x', '/', ':', '@', '`', ' ', '\0', (char) 0x80, (char) 0xB0, (char) 0xFF };
+    char            str[2*256+1];
+    uint8_t         data[256], dataRef[256], sum, sumRef;
+    uint32_t        seed = 7;
+
+    for (size_t len = 0; len < 256; len++) {
+
+        // encode random bytes with random case. Odd offset for unaligned SIMD loads
+        for (size_t i = 0; i < 2*len; i++) {
+            seed = seed * 1103515245 + 12345;
+            uint8_t nibble = (i & 1) ? testData[len+i/2] & 0x0F : testData[len+i/2] >> 4;
+            str[1+i] = digits[nibble + ((seed >> 20) & 16)];
+        }
+
+        // valid string -> same data and checksum
+        sum = sumRef = (uint8_t) len;
+        TEST_ASSERT_TRUE(hex_decode_ref(dataRef, str+1, len, &sumRef));
+        TEST_ASSERT_TRUE(hex_decode(data, str+1, len, &sum));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(dataRef, data, len);
+        TEST_ASSERT_EQUAL_HEX8(sumRef, sum);
+
+        // single invalid character at random position -> error
+        for (size_t k = 0; (len > 0) && (k < sizeof(invalid)); k++) {
+            seed = seed * 1103515245 + 12345;
+            size_t pos = (k == 0) ? 0 : (k == 1) ? 2*len-1 : (seed >> 8) % (2*len);
+            char c = str[1+pos];
+            str[1+pos] = invalid[k];
+            TEST_ASSERT_FALSE(hex_decode_ref(dataRef, str+1, len, &sumRef));
+            TEST_ASSERT_FALSE(hex_decode(data, str+1, len, &sum));
+            str[1+pos] = c;
+        }
+    }
+
+}
+
+/// random single byte and block operations match reference model
+void test_memimage_random_ops(void) {
+
+    static RefImage_s   ref;
+    MemoryImage_s       image;
+    uint8_t             buf[256], data;
+    uint32_t            seed = 11;
+
+    memset(&ref, 0, sizeof(ref));
+    MemoryImage_init(&image);
+    for (int n = 0; n < 3000; n++) {
+        size_t addr = random_next(&seed, REF_SIZE);
+        size_t len  = 1 + random_next(&seed, 200);
+        size_t ofs  = random_next(&seed, TEST_DATA_SIZE - 200);
+        size_t end  = (addr + len > REF_SIZE) ? REF_SIZE - 1 : addr + len - 1;
+        switch (random_next(&seed, 8)) {
+
+            case 0:     // add single byte
+                TEST_ASSERT_TRUE(MemoryImage_addData(&image, addr, testData[ofs]));
+                ref_add(&ref, addr, testData + ofs, 1);
+                break;
+
+            case 1:     // add block, may overlap or join existing segments
+                TEST_ASSERT_TRUE(MemoryImage_addBlock(&image, addr, testData + ofs, end - addr + 1));
+                ref_add(&ref, addr, testData + ofs, end - addr + 1);
+                break;
+
+            case 2:     // delete single byte, may split segment
+                MemoryImage_deleteData(&image, addr);
+                ref_delete(&ref, addr, addr);
+                break;
+
+            case 3:     // delete range
+                TEST_ASSERT_TRUE(MemoryImage_deleteRange(&image, addr, end));
+                ref_delete(&ref, addr, end);
+                break;
+
+            case 4:     // cut range
+                TEST_ASSERT_TRUE(MemoryImage_cut(&image, addr, end));
+                ref_delete(&ref, addr, end);
+                break;
+
+            case 5:     // fill range with value
+                TEST_ASSERT_TRUE(MemoryImage_fillValue(&image, addr, end, testData[ofs]));
+                memset(buf, testData[ofs], sizeof(buf));
+                ref_add(&ref, addr, buf, end - addr + 1);
+                break;
+
+            case 6:     // read block. Missing data is 0x00
+                if (len > sizeof(buf))
+                    len = sizeof(buf);
+                {
+                    bool complete = true;
+                    for (size_t i = 0; i < len; i++)
+                        complete &= (addr + i < REF_SIZE) && (ref.used[addr + i]);
+                    TEST_ASSERT_EQUAL(complete, MemoryImage_getBlock(&image, addr, buf, len));
+                    for (size_t i = 0; i < len; i++)
+                        TEST_ASSERT_EQUAL_HEX8(((addr + i < REF_SIZE) && (ref.used[addr + i])) ? ref.data[addr + i] : 0x00, buf[i]);
+                }
+                break;
+
+            default:    // read single byte
+                TEST_ASSERT_EQUAL(ref.used[addr], MemoryImage_getData(&image, addr, &data));
+                if (ref.used[addr])
+                    TEST_ASSERT_EQUAL_HEX8(ref.data[addr], data);
+                break;
+        }
+        check_image(&image, &ref);
+    }
+
+    // clip to range
+    TEST_ASSERT_TRUE(MemoryImage_clip(&image, 1000, 2999));
+    ref_delete(&ref, 0, 999);
+    ref_delete(&ref, 3000, REF_SIZE-1);
+    check_image(&image, &ref);
+    MemoryImage_free(&image);
+
+}
+
+/// ascending addresses are appended without search
+void test_memimage_append(void) {
+
+    static RefImage_s   ref;
+    MemoryImage_s       image;
+    uint32_t            seed = 12;
+
+    memset(&ref, 0, sizeof(ref));
+    MemoryImage_init(&image);
+    for (size_t addr = random_next(&seed, 4); addr < REF_SIZE - 100; addr += 1 + random_next(&seed, 4)) {
+        if (addr & 1) {
+            TEST_ASSERT_TRUE(MemoryImage_addData(&image, addr, testData[addr % TEST_DATA_SIZE]));
+            ref_add(&ref, addr, testData + addr % TEST_DATA_SIZE, 1);
+        }
+        else {
+            TEST_ASSERT_TRUE(MemoryImage_addBlock(&image, addr, testData, 3));
+            ref_add(&ref, addr, testData, 3);
+            addr += 2;
+        }
+    }
+    TEST_ASSERT_EQUAL(0, image.countSearch);
+    TEST_ASSERT_TRUE(image.countAppend > 0);
+    check_image(&image, &ref);
+    MemoryImage_free(&image);
+
+}
+
+/// staged unsorted data with repeated addresses is committed like sequential insertion
+void test_memimage_staging(void) {
+
+    static RefImage_s   ref;
+    MemoryImage_s       image;
+    MemoryStaging_s     staging;
+    uint32_t            seed = 13;
+
+    memset(&ref, 0, sizeof(ref));
+    MemoryImage_init(&image);
+    fill_random_blocks(&image, &ref, 10, &seed);
+    MemoryStaging_init(&staging);
+    for (int n = 0; n < 5000; n++) {
+        size_t  addr = random_next(&seed, REF_SIZE);
+        uint8_t data = (uint8_t) random_next(&seed, 256);
+        TEST_ASSERT_TRUE(MemoryStaging_addData(&staging, addr, data));
+        ref_add(&ref, addr, &data, 1);
+    }
+    TEST_ASSERT_TRUE(MemoryStaging_commit(&staging, &image));
+    TEST_ASSERT_EQUAL(0, staging.numEntries);
+    check_image(&image, &ref);
+    MemoryImage_free(&image);
+
+}
+
+/// copy and move of ranges with overlapping source and destination match reference model
+void test_memimage_copy_move(void) {
+
+    static RefImage_s   ref;
+    MemoryImage_s       image;
+    uint32_t            seed = 14;
+
+    for (int n = 0; n < 400; n++) {
+        memset(&ref, 0, sizeof(ref));
+        MemoryImage_init(&image);
+        fill_random_blocks(&image, &ref, 1 + n % 8, &seed);
+
+        // source range and destination within model, shifted by up to +/-300 for overlap
+        size_t addrStart = random_next(&seed, REF_SIZE - 1000) + 500;
+        size_t addrEnd   = addrStart + random_next(&seed, 400);
+        size_t addrTo    = addrStart + random_next(&seed, 601) - 300;
+        bool   move      = (n & 1);
+
+        if (move)
+            TEST_ASSERT_TRUE(MemoryImage_moveRange(&image, addrStart, addrEnd, addrTo));
+        else
+            TEST_ASSERT_TRUE(MemoryImage_copyRange(&image, addrStart, addrEnd, addrTo));
+        ref_copy(&ref, addrStart, addrEnd, addrTo, move);
+        check_image(&image, &ref);
+        MemoryImage_free(&image);
+    }
+
+}
+
+/// k-way merge gives priority to later images in list, also with destination as source
+void test_memimage_merge_images(void) {
+
+    static RefImage_s   ref, refSrc[4];
+    MemoryImage_s       image, src[4];
+    const MemoryImage_s *list[5];
+    uint32_t            seed = 15;
+
+    for (int n = 0; n < 50; n++) {
+
+        // destination is first (lowest priority) source
+        memset(&ref, 0, sizeof(ref));
+        MemoryImage_init(&image);
+        fill_random_blocks(&image, &ref, 5, &seed);
+        list[0] = &image;
+
+        // later images overwrite earlier ones
+        for (int i = 0; i < 4; i++) {
+            memset(&(refSrc[i]), 0, sizeof(RefImage_s));
+            MemoryImage_init(&(src[i]));
+            fill_random_blocks(&(src[i]), &(refSrc[i]), n % 6, &seed);
+            list[i+1] = &(src[i]);
+            for (size_t addr = 0; addr < REF_SIZE; addr++) {
+                if (refSrc[i].used[addr])
+                    ref_add(&ref, addr, &(refSrc[i].data[addr]), 1);
+            }
+        }
+        TEST_ASSERT_TRUE(MemoryImage_mergeImages(list, 5, &image));
+        check_image(&image, &ref);
+
+        // pairwise merge, source has priority
+        for (size_t addr = 0; addr < REF_SIZE; addr++) {
+            if (refSrc[0].used[addr])
+                ref_add(&ref, addr, &(refSrc[0].data[addr]), 1);
+        }
+        TEST_ASSERT_TRUE(MemoryImage_merge(&(src[0]), &image));
+        check_image(&image, &ref);
+
+        for (int i = 0; i < 4; i++)
+            MemoryImage_free(&(src[i]));
+        MemoryImage_free(&image);
+    }
+
+}
+
+/// S19 and IHX export and import restore the image, also for parallel chunked parsing
+void test_records_roundtrip(void) {
+
+    MemoryImage_s   image, imageRead;
+    char            filename[] = TEST_FILE;
+    const size_t    lenLarge = 700*1024;
+    uint8_t         *large = (uint8_t*) malloc(lenLarge);
+    const int       threads[] = { 1, 4 };
+
+    // blocks incl. 64kB boundary (IHX ELA record), 24 bit and 32 bit addresses (S2/S3 records), and large block for chunked parsing
+    TEST_ASSERT_NOT_NULL(large);
+    fill_random(large, lenLarge, 3);
+    MemoryImage_init(&image);
+    TEST_ASSERT_TRUE(MemoryImage_addBlock(&image, 0x0000, testData, 1));
+    TEST_ASSERT_TRUE(MemoryImage_addBlock(&image, 0x0100, testData, 77));
+    TEST_ASSERT_TRUE(MemoryImage_addBlock(&image, 0xFFF0, testData, 100));
+    TEST_ASSERT_TRUE(MemoryImage_addBlock(&image, 0x123456, testData, 300));
+    TEST_ASSERT_TRUE(MemoryImage_addBlock(&image, 0x1234FFF7, large, lenLarge));
+
+    for (int format = 0; format < 2; format++) {
+        if (format == 0)
+            export_file_s19(filename, &image, MUTE);
+        else
+            export_file_ihx(filename, &image, MUTE);
+        for (size_t t = 0; t < sizeof(threads)/sizeof(threads[0]); t++) {
+            MemoryImage_init(&imageRead);
+            if (format == 0)
+                import_file_s19(filename, &imageRead, threads[t], MUTE);
+            else
+                import_file_ihx(filename, &imageRead, threads[t], MUTE);
+            compare_images(&image, &imageRead);
+            MemoryImage_free(&imageRead);
+        }
+    }
+    remove(filename);
+    MemoryImage_free(&image);
+    free(large);
+
+}
+
+/// invalid records are reported with line number, preceding records are kept
+void test_records_errors(void) {
+
+    MemoryImage_s   image;
+    char            error[IMPORT_ERROR_LEN];
+    uint8_t         data;
+    const struct {
+        bool        ihx;
+        const char  *buf;
+        const char  *error;
+    } tests[] = {
+        { false, "S1050000AABB95\n\nS1050002CCDD4E\n",  "Line 3 in Motorola S-record: checksum error" },
+        { false, "S1050000AABB95\nX1050002CCDD4F\n",    "Line 2 in Motorola S-record: line does not start with 'S'" },
+        { false, "S1050000AABB95\nS1050002CCDG4F\n",    "Line 2 in Motorola S-record: invalid hex character" },
+        { false, "S1050000AABB95\nS1050002CC\n",        "Line 2 in Motorola S-record: invalid hex character or record too short" },
+        { true,  ":02000000AABB99\n:02000200CCDD54\n",  "Line 2 in Intel hex record: checksum error" },
+        { true,  ":02000000AABB99\n:020000021000EC\n",  "Line 2 in Intel hex record: extended segment address" },
+        { true,  ":02000000AABB99\n:0200020GCCDD55\n",  "Line 2 in Intel hex record: invalid hex character" },
+        { true,  ":02000000AABB99\nS2000000AABB99\n",   "Line 2 in Intel hex record: line does not start with ':'" }
+    };
+
+    for (size_t i = 0; i < sizeof(tests)/sizeof(tests[0]); i++) {
+        MemoryImage_init(&image);
+        memset(error, 0, sizeof(error));
+        const uint8_t *buf = (const uint8_t*) tests[i].buf;
+        if (tests[i].ihx)
+            TEST_ASSERT_FALSE(import_buffer_ihx_len(buf, strlen(tests[i].buf), &image, error));
+        else
+            TEST_ASSERT_FALSE(import_buffer_s19_len(buf, strlen(tests[i].buf), &image, error));
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(tests[i].error, error, strlen(tests[i].error), error);
+        TEST_ASSERT_EQUAL(2, image.numEntries);
+        TEST_ASSERT_TRUE(MemoryImage_getData(&image, 0x0001, &data));
+        TEST_ASSERT_EQUAL_HEX8(0xBB, data);
+        MemoryImage_free(&image);
+    }
+
+    // valid buffers without terminating newline, with CRLF and empty lines
+    const char *s19 = "S00600004844521B\r\nS1050000AABB95\r\n\r\nS9030000FC";
+    const char *ihx = ":020000040001F9\n:02000000AABB99\n:00000001FF";
+    MemoryImage_init(&image);
+    TEST_ASSERT_TRUE(import_buffer_s19_len((const uint8_t*) s19, strlen(s19), &image, error));
+    TEST_ASSERT_TRUE(import_buffer_ihx_len((const uint8_t*) ihx, strlen(ihx), &image, error));
+    TEST_ASSERT_EQUAL(4, image.numEntries);
+    TEST_ASSERT_TRUE(MemoryImage_getData(&image, 0x10000, &data));
+    TEST_ASSERT_EQUAL_HEX8(0xAA, data);
+    MemoryImage_free(&image);
+
+}
+
+/// ASCII table accepts decimal and hex numbers, comments and extra columns, rejects malformed lines
+void test_table(void) {
+
+    static RefImage_s   ref;
+    MemoryImage_s       image;
+    char                error[IMPORT_ERROR_LEN];
+    const char          *table = "# comment\n\n0x20 0x01\n16\t255 extra column\r\n  0x1F   0Xab\n0x20 2\n";
+    const uint8_t       data[] = { 0xFF, 0xAB, 0x02 };
+    const struct {
+        const char  *buf;
+        const char  *error;
+    } tests[] = {
+        { "0x10 1\n0x14 256\n",                 "Line 2 in table: invalid value '256'" },
+        { "0x10 1\n0x14\n",                     "Line 2 in table: missing value" },
+        { "0x10 1\n\n0x1G 1\n",                 "Line 3 in table: invalid address '0x1G'" },
+        { "0x10 1\n0x11 0x\n",                  "Line 2 in table: invalid value '0x'" },
+        { "0x10000000000000000 1\n",            "Line 1 in table: invalid address '0x10000000000000000'" },
+        { "18446744073709551616 1\n",           "Line 1 in table: invalid address '18446744073709551616'" }
+    };
+
+    // unsorted table with repeated address, last entry wins
+    memset(&ref, 0, sizeof(ref));
+    MemoryImage_init(&image);
+    TEST_ASSERT_TRUE(import_buffer_txt_len((const uint8_t*) table, strlen(table), &image, error));
+    ref_add(&ref, 0x10, data, 1);
+    ref_add(&ref, 0x1F, data + 1, 2);
+    check_image(&image, &ref);
+    MemoryImage_free(&image);
+
+    // malformed lines are rejected with line number, image is unchanged
+    for (size_t i = 0; i < sizeof(tests)/sizeof(tests[0]); i++) {
+        MemoryImage_init(&image);
+        TEST_ASSERT_FALSE(import_buffer_txt_len((const uint8_t*) tests[i].buf, strlen(tests[i].buf), &image, error));
+        TEST_ASSERT_EQUAL_STRING(tests[i].error, error);
+        TEST_ASSERT_EQUAL(0, image.numEntries);
+        MemoryImage_free(&image);
+    }
+
+}
+
+/// file format is detected from content
+void test_detect_format(void) {
+
+    const uint8_t   binary[] = { 0x00, 0x01, 0x02, 0xFF };
+    const struct {
+        const char  *buf;
+        format_t    format;
+    } tests[] = {
+        { "S00600004844521B\nS1050000AABB95\n",     FORMAT_S19 },
+        { "\r\nS1050000AABB95",                     FORMAT_S19 },
+        { ":02000000AABB99\n:00000001FF\n",         FORMAT_IHX },
+        { "# table\n0x10 0x20\n17 3\n",             FORMAT_TXT },
+        { "# only comment\n",                       FORMAT_TXT },
+        { "hello world\n",                          FORMAT_BIN },
+        { "0x10\n",                                 FORMAT_BIN },
+        { "",                                       FORMAT_BIN }
+    };
+
+    for (size_t i = 0; i < sizeof(tests)/sizeof(tests[0]); i++)
+        TEST_ASSERT_EQUAL_MESSAGE(tests[i].format, detect_format((const uint8_t*) tests[i].buf, strlen(tests[i].buf)), tests[i].buf);
+    TEST_ASSERT_EQUAL(FORMAT_BIN, detect_format(binary, sizeof(binary)));
+
+}
+
+/// binary export fills gaps with fill value, also via sparse holes for 0x00
+void test_export_bin(void) {
+
+    MemoryImage_s   image;
+    char            filename[] = TEST_FILE;
+    const uint8_t   fill[] = { 0xFF, 0x00 };
+    const size_t    addrStart = 0x10, addrLarge = 0x10000, lenLarge = 300*1024;
+    const size_t    lenFile = addrLarge + lenLarge + 0x20000 + 10 - addrStart;
+    uint8_t         *large = (uint8_t*) malloc(lenLarge);
+    uint8_t         *buf = (uint8_t*) malloc(lenFile + 1);
+
+    // small blocks, large block and large gap
+    TEST_ASSERT_NOT_NULL(large);
+    TEST_ASSERT_NOT_NULL(buf);
+    fill_random(large, lenLarge, 4);
+    MemoryImage_init(&image);
+    TEST_ASSERT_TRUE(MemoryImage_addBlock(&image, addrStart, testData, 100));
+    TEST_ASSERT_TRUE(MemoryImage_addBlock(&image, addrLarge, large, lenLarge));
+    TEST_ASSERT_TRUE(MemoryImage_addBlock(&image, addrLarge + lenLarge + 0x20000, testData, 10));
+
+    for (size_t f = 0; f < sizeof(fill); f++) {
+
+        // export and read back
+        export_file_bin(filename, &image, fill[f], MUTE);
+        FILE *fp = fopen(filename, "rb");
+        TEST_ASSERT_NOT_NULL(fp);
+        size_t len = fread(buf, 1, lenFile + 1, fp);
+        fclose(fp);
+        TEST_ASSERT_EQUAL(lenFile, len);
+
+        // compare data and gaps
+        for (size_t i = 0; i < lenFile; i++) {
+            uint8_t data;
+            if (!MemoryImage_getData(&image, addrStart + i, &data))
+                data = fill[f];
+            if (buf[i] != data)
+                TEST_ASSERT_EQUAL_HEX8_MESSAGE(data, buf[i], "mismatch in exported file");
+        }
+    }
+    remove(filename);
+    MemoryImage_free(&image);
+    free(large);
+    free(buf);
+
+}
+
+
 int main( int argc, char **argv) {
+    fill_random(testData, sizeof(testData), 1);
     UNITY_BEGIN();
-    UNITY_END();
+    RUN_TEST(test_crc32_update);
+    RUN_TEST(test_crc32_update_split);
+    RUN_TEST(test_crc32_join);
+    RUN_TEST(test_checksum_image_threads);
+    RUN_TEST(test_checksum_check_values);
+    RUN_TEST(test_checksum_sha256_chunks);
+    RUN_TEST(test_checksum_fill);
+    RUN_TEST(test_hex_decode);
+    RUN_TEST(test_memimage_random_ops);
+    RUN_TEST(test_memimage_append);
+    RUN_TEST(test_memimage_staging);
+    RUN_TEST(test_memimage_copy_move);
+    RUN_TEST(test_memimage_merge_images);
+    RUN_TEST(test_records_roundtrip);
+    RUN_TEST(test_records_errors);
+    RUN_TEST(test_table);
+    RUN_TEST(test_detect_format);
+    RUN_TEST(test_export_bin);
+    return UNITY_END();
 }